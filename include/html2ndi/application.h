@@ -1,9 +1,12 @@
 #pragma once
 
 #include "html2ndi/config.h"
+#include "html2ndi/config_store.h"
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace html2ndi {
@@ -12,9 +15,16 @@ namespace html2ndi {
 class OffscreenRenderer;
 class NdiSender;
 class FramePump;
+class AudioPump;
+class PatternGenerator;
+class ProxyStream;
 class HttpServer;
+class EventStream;
 class Logger;
 class GenlockClock;
+class ShmPreview;
+class Watchdog;
+class LatencyHistogram;
 
 /**
  * Main application class.
@@ -65,6 +75,47 @@ public:
      * Reload the current page.
      */
     void reload();
+
+    /**
+     * Change the output resolution at runtime without interrupting the
+     * stream: the pump pre-allocates new-size buffers, the browser is
+     * resized, and the last old-size frame keeps repeating until the
+     * first new-size paint lands - then the output flips on a frame
+     * boundary. Thread-safe; called from the HTTP API.
+     * @param width New frame width
+     * @param height New frame height
+     * @return true if the resize was staged (or was a no-op)
+     */
+    bool resize(int width, int height);
+
+    /**
+     * Go live from warm-spare mode: create the NDI sender and frame pump
+     * (deferred by --prewarm) and navigate to the real URL. CEF is already
+     * initialized at this point, so the first frame reaches NDI in well
+     * under a second instead of a full cold start.
+     * Thread-safe; called from the HTTP API.
+     * @param url URL to load
+     * @param ndi_name NDI source name (empty = configured default)
+     * @return true if activation succeeded, false if already live
+     */
+    bool activate(const std::string& url, const std::string& ndi_name);
+
+    /**
+     * True while running as an idle warm spare (before activate()).
+     */
+    bool prewarmed() const { return config_.prewarm && !activated_; }
+
+    /**
+     * Milliseconds from process start to the first frame submitted to the
+     * pump (0 until that happens).
+     */
+    double time_to_first_frame_ms() const { return time_to_first_frame_ms_; }
+
+    /**
+     * Milliseconds from activate() to the first live frame (warm-spare
+     * mode only, 0 otherwise).
+     */
+    double activation_to_first_frame_ms() const { return activation_to_first_frame_ms_; }
     
     /**
      * Get the current configuration.
@@ -93,12 +144,14 @@ public:
     
     /**
      * Get a JPEG thumbnail of the current frame.
-     * @param out_jpeg Output JPEG data
+     * Encodes are cached per (frame generation, width, quality), so repeat
+     * polls of unchanged content return the same bytes with no frame copy
+     * and no re-encode.
      * @param width Target width (0 for original)
      * @param quality JPEG quality (1-100)
-     * @return true if thumbnail was generated
+     * @return Shared JPEG data, or nullptr if no frame was available
      */
-    bool get_thumbnail(std::vector<uint8_t>& out_jpeg, int width = 320, int quality = 75);
+    std::shared_ptr<const std::vector<uint8_t>> get_thumbnail(int width = 320, int quality = 75);
     
     /**
      * Get genlock clock (may be null).
@@ -115,19 +168,167 @@ public:
      */
     OffscreenRenderer* renderer() { return renderer_.get(); }
 
+    /**
+     * Paint-interval percentile histogram of the primary browser
+     * (nullptr before CEF initialization).
+     */
+    const LatencyHistogram* paint_histogram() const;
+
+    /**
+     * Zero all latency percentile histograms (submit, memcpy, wakeup,
+     * paint interval). Operator-triggered via POST /latency/reset.
+     */
+    void reset_latency_histograms();
+
+    /**
+     * Get audio pump (nullptr unless --audio).
+     */
+    AudioPump* audio_pump() { return audio_pump_.get(); }
+
+    /**
+     * Get test-pattern generator (nullptr unless --pattern).
+     */
+    PatternGenerator* pattern_generator() { return pattern_generator_.get(); }
+
+    /**
+     * Get the low-bandwidth proxy stream (nullptr unless enabled).
+     */
+    ProxyStream* proxy_stream() { return proxy_stream_.get(); }
+
+    /**
+     * True while the unwatched-source governor has the render and send
+     * rate dropped (--throttle).
+     */
+    bool render_throttled() const { return render_throttled_; }
+
+    /**
+     * Enable the ".proxy" output at runtime (HTTP API). No-op if the
+     * proxy is already running.
+     * @param width Proxy downscale width
+     * @param fps Proxy send rate
+     * @return true if the proxy is running when this returns
+     */
+    bool enable_proxy(int width, int fps);
+
+    /**
+     * Stop and tear down the proxy output. Safe when not running.
+     */
+    void disable_proxy();
+
+    /**
+     * Get the server-sent-events hub backing GET /events.
+     */
+    EventStream* events() { return events_.get(); }
+
+    /**
+     * Get shared-memory preview publisher (nullptr unless --shm-preview).
+     */
+    ShmPreview* shm_preview() { return shm_preview_.get(); }
+
+    /**
+     * Get the main-loop watchdog / stall profiler.
+     */
+    Watchdog* watchdog() { return watchdog_.get(); }
+
+    /**
+     * Get the hot-reloadable config store.
+     */
+    ConfigStore* config_store() { return config_store_.get(); }
+
+    /**
+     * Number of additional streams (multi-stream mode).
+     */
+    size_t stream_count() const { return streams_.size(); }
+
+    /**
+     * Get an additional stream's NDI name.
+     * @param index Stream index (0-based), must be < stream_count()
+     */
+    const std::string& stream_name(size_t index) const;
+
+    /**
+     * Get an additional stream's frame pump (nullptr if out of range).
+     */
+    FramePump* stream_pump(size_t index);
+
+    /**
+     * Get an additional stream's NDI sender (nullptr if out of range).
+     */
+    NdiSender* stream_sender(size_t index);
+
+    /**
+     * Get an additional stream's current URL.
+     */
+    std::string stream_url(size_t index) const;
+
+    /**
+     * Navigate an additional stream to a new URL.
+     */
+    void stream_set_url(size_t index, const std::string& url);
+
+    /**
+     * Reload an additional stream's page.
+     */
+    void stream_reload(size_t index);
+
 private:
+    void register_metrics();
+
+    // Shared between initialize() (normal start) and activate() (warm spare)
+    bool create_sender_and_pump(const std::string& ndi_name);
+
+    // Build the ".proxy" sender tapped off the primary pump (startup and
+    // HTTP enable share this)
+    bool create_proxy_stream(const std::string& base_name, int width, int fps);
+
+    // First submit_frame instrumentation (time to first frame)
+    void record_first_frame();
+
+    // One additional browser -> pump -> sender pipeline (multi-stream mode)
+    struct Stream {
+        std::string ndi_name;
+        int renderer_stream_id{-1};
+        std::unique_ptr<NdiSender> sender;
+        std::unique_ptr<FramePump> pump;
+    };
+
     Config config_;
     std::atomic<bool> shutdown_requested_{false};
     
     std::unique_ptr<OffscreenRenderer> renderer_;
     std::unique_ptr<NdiSender> ndi_sender_;
     std::unique_ptr<FramePump> frame_pump_;
+    std::unique_ptr<AudioPump> audio_pump_;
+    std::unique_ptr<PatternGenerator> pattern_generator_;
+    std::unique_ptr<ProxyStream> proxy_stream_;
+    std::mutex proxy_mutex_;  // Serializes HTTP enable/disable of the proxy
     std::unique_ptr<HttpServer> http_server_;
+    std::unique_ptr<EventStream> events_;
     std::shared_ptr<GenlockClock> genlock_clock_;
+    std::unique_ptr<ShmPreview> shm_preview_;
+    std::unique_ptr<Watchdog> watchdog_;
+    std::unique_ptr<ConfigStore> config_store_;
+    std::vector<std::unique_ptr<Stream>> streams_;
     
     // Actual measured FPS
     std::atomic<float> actual_fps_{0.0f};
     std::atomic<std::string*> current_url_;
+
+    // Warm-spare / time-to-first-frame instrumentation
+    std::atomic<bool> activated_{false};
+    std::atomic<bool> first_frame_seen_{false};
+    std::atomic<bool> render_throttled_{false};
+    std::atomic<double> time_to_first_frame_ms_{0.0};
+    std::atomic<double> activation_to_first_frame_ms_{0.0};
+    std::chrono::steady_clock::time_point activation_time_;
+    std::mutex activate_mutex_;
+
+    // Thumbnail cache, keyed by (frame generation, width, quality)
+    std::mutex thumbnail_mutex_;
+    std::shared_ptr<const std::vector<uint8_t>> thumbnail_cache_;
+    uint64_t thumbnail_generation_{0};
+    int thumbnail_width_{0};
+    int thumbnail_quality_{0};
     
     // Performance monitoring
     std::chrono::steady_clock::time_point start_time_;
@@ -137,10 +338,12 @@ private:
     
     // Performance monitoring thresholds (constants)
     static constexpr int kWatchdogStartupDelay = 60;        // seconds
+    static constexpr int kWatchdogTimeout = 30;             // seconds (hard abort)
     static constexpr float kFpsThresholdRatio = 0.5f;       // 50% of target
     static constexpr int kDegradationCheckCount = 5;        // consecutive checks
     static constexpr int kMinReloadInterval = 30;           // seconds
     static constexpr int kGarbageCollectionInterval = 300;  // seconds (5 min)
+    static constexpr int kThrottleGraceSeconds = 5;         // unwatched before throttling
 };
 
 } // namespace html2ndi
@@ -4,6 +4,9 @@
 #include "include/cef_browser_process_handler.h"
 #include "include/cef_render_process_handler.h"
 
+#include <cstdint>
+#include <functional>
+
 namespace html2ndi {
 
 /**
@@ -14,8 +17,22 @@ class CefAppImpl : public CefApp,
                    public CefBrowserProcessHandler,
                    public CefRenderProcessHandler {
 public:
+    /**
+     * Called from OnScheduleMessagePumpWork (any thread) with the delay
+     * CEF requested before the next CefDoMessageLoopWork call.
+     */
+    using ScheduleCallback = std::function<void(int64_t delay_ms)>;
+
     CefAppImpl() = default;
-    
+
+    /**
+     * Set the external message pump scheduling callback.
+     * Must be set before CefInitialize when external_message_pump is on.
+     */
+    void set_schedule_callback(ScheduleCallback callback) {
+        schedule_callback_ = std::move(callback);
+    }
+
     // CefApp methods
     CefRefPtr<CefBrowserProcessHandler> GetBrowserProcessHandler() override {
         return this;
@@ -31,9 +48,11 @@ public:
     
     // CefBrowserProcessHandler methods
     void OnContextInitialized() override;
-    
+
     CefRefPtr<CefClient> GetDefaultClient() override;
-    
+
+    void OnScheduleMessagePumpWork(int64_t delay_ms) override;
+
     // CefRenderProcessHandler methods
     void OnContextCreated(
         CefRefPtr<CefBrowser> browser,
@@ -41,6 +60,8 @@ public:
         CefRefPtr<CefV8Context> context) override;
 
 private:
+    ScheduleCallback schedule_callback_;
+
     IMPLEMENT_REFCOUNTING(CefAppImpl);
     DISALLOW_COPY_AND_ASSIGN(CefAppImpl);
 };
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "html2ndi/frame_rect.h"
+#include "html2ndi/utils/latency_histogram.h"
+
+#include "include/cef_audio_handler.h"
 #include "include/cef_client.h"
 #include "include/cef_render_handler.h"
 #include "include/cef_life_span_handler.h"
@@ -7,6 +11,7 @@
 #include "include/cef_display_handler.h"
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <mutex>
 #include <string>
@@ -20,8 +25,21 @@ namespace html2ndi {
  * @param buffer RGBA pixel data
  * @param width Frame width
  * @param height Frame height
+ * @param dirty_rects Regions of the buffer that changed since the last frame
+ */
+using FrameCallback = std::function<void(const void* buffer, int width, int height,
+                                         const FrameRectList& dirty_rects)>;
+
+/**
+ * Audio capture callbacks.
+ * Started/stopped run on the CEF UI thread; the packet callback runs on
+ * CEF's dedicated audio thread and must never block.
+ * @param data Planar float PCM, one pointer per channel
+ * @param frames Number of samples per channel
  */
-using FrameCallback = std::function<void(const void* buffer, int width, int height)>;
+using AudioStartedCallback = std::function<void(int sample_rate, int channels)>;
+using AudioPacketCallback = std::function<void(const float** data, int frames)>;
+using AudioStoppedCallback = std::function<void()>;
 
 /**
  * CEF client handler.
@@ -31,16 +49,23 @@ class CefHandler : public CefClient,
                    public CefRenderHandler,
                    public CefLifeSpanHandler,
                    public CefLoadHandler,
-                   public CefDisplayHandler {
+                   public CefDisplayHandler,
+                   public CefAudioHandler {
 public:
     CefHandler(int width, int height, FrameCallback callback);
     ~CefHandler() override;
-    
+
     // CefClient methods
     CefRefPtr<CefRenderHandler> GetRenderHandler() override { return this; }
     CefRefPtr<CefLifeSpanHandler> GetLifeSpanHandler() override { return this; }
     CefRefPtr<CefLoadHandler> GetLoadHandler() override { return this; }
     CefRefPtr<CefDisplayHandler> GetDisplayHandler() override { return this; }
+
+    CefRefPtr<CefAudioHandler> GetAudioHandler() override {
+        // Only intercept audio when someone is listening; returning null
+        // keeps CEF's normal audio output path
+        return audio_packet_callback_ ? CefRefPtr<CefAudioHandler>(this) : nullptr;
+    }
     
     // CefRenderHandler methods
     void GetViewRect(CefRefPtr<CefBrowser> browser, CefRect& rect) override;
@@ -53,6 +78,12 @@ public:
         int width,
         int height) override;
     
+    void OnAcceleratedPaint(
+        CefRefPtr<CefBrowser> browser,
+        PaintElementType type,
+        const RectList& dirtyRects,
+        const CefAcceleratedPaintInfo& info) override;
+
     bool GetScreenInfo(
         CefRefPtr<CefBrowser> browser,
         CefScreenInfo& screen_info) override;
@@ -91,7 +122,34 @@ public:
         const CefString& message,
         const CefString& source,
         int line) override;
-    
+
+    // CefAudioHandler methods
+    void OnAudioStreamStarted(
+        CefRefPtr<CefBrowser> browser,
+        const CefAudioParameters& params,
+        int channels) override;
+
+    void OnAudioStreamPacket(
+        CefRefPtr<CefBrowser> browser,
+        const float** data,
+        int frames,
+        int64_t pts) override;
+
+    void OnAudioStreamStopped(CefRefPtr<CefBrowser> browser) override;
+
+    void OnAudioStreamError(
+        CefRefPtr<CefBrowser> browser,
+        const CefString& message) override;
+
+    /**
+     * Install audio capture callbacks.
+     * Must be called before the browser is created: CEF queries
+     * GetAudioHandler once at stream setup.
+     */
+    void SetAudioCallbacks(AudioStartedCallback started,
+                           AudioPacketCallback packet,
+                           AudioStoppedCallback stopped);
+
     // Browser control
     void SetBrowser(CefRefPtr<CefBrowser> browser);
     CefRefPtr<CefBrowser> GetBrowser() const;
@@ -102,16 +160,29 @@ public:
     
     // Resize viewport
     void Resize(int width, int height);
+
+    // Change the windowless (OSR) paint rate at runtime
+    void SetFrameRate(int fps);
     
     // Performance metrics
-    double avg_paint_interval_ms() const { return avg_paint_interval_ms_; }
+    double avg_paint_interval_ms() const { return paint_histogram_.mean() / 1000.0; }
     uint64_t paint_count() const { return paint_count_; }
 
+    // Paint interval percentiles (microseconds); keeps the tail spikes
+    // the old moving average hid
+    const LatencyHistogram& paint_histogram() const { return paint_histogram_; }
+    void reset_paint_histogram() { paint_histogram_.reset(); }
+
 private:
     int width_;
     int height_;
     FrameCallback frame_callback_;
-    
+
+    // Audio capture (unset = audio stays on CEF's normal output path)
+    AudioStartedCallback audio_started_callback_;
+    AudioPacketCallback audio_packet_callback_;
+    AudioStoppedCallback audio_stopped_callback_;
+
     mutable std::mutex browser_mutex_;
     CefRefPtr<CefBrowser> browser_;
     std::atomic<bool> is_closed_{false};
@@ -121,8 +192,11 @@ private:
     
     // Performance tracking
     std::atomic<uint64_t> paint_count_{0};
-    std::atomic<double> avg_paint_interval_ms_{0.0};
+    LatencyHistogram paint_histogram_;  // Paint-to-paint interval in us
     std::chrono::steady_clock::time_point last_paint_time_;
+
+    // Staging buffer for repacking padded IOSurface rows (accelerated OSR)
+    std::vector<uint8_t> accelerated_staging_;
     
     IMPLEMENT_REFCOUNTING(CefHandler);
     DISALLOW_COPY_AND_ASSIGN(CefHandler);
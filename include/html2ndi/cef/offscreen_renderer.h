@@ -4,10 +4,14 @@
 #include "html2ndi/cef/cef_handler.h"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace html2ndi {
 
@@ -29,6 +33,15 @@ public:
     OffscreenRenderer(const OffscreenRenderer&) = delete;
     OffscreenRenderer& operator=(const OffscreenRenderer&) = delete;
     
+    /**
+     * Install audio capture callbacks on the primary browser.
+     * Must be called before initialize(): CEF queries GetAudioHandler
+     * once at browser creation.
+     */
+    void set_audio_callbacks(AudioStartedCallback started,
+                             AudioPacketCallback packet,
+                             AudioStoppedCallback stopped);
+
     /**
      * Initialize CEF and create browser.
      * Must be called from the main thread.
@@ -47,7 +60,15 @@ public:
      * Returns immediately.
      */
     void do_message_loop_work();
-    
+
+    /**
+     * Sleep until CEF has scheduled message loop work (external pump),
+     * bounded by max_wait so callers can keep servicing heartbeats and
+     * monitoring. Replaces the fixed 1 ms polling sleep: idle workers
+     * block here instead of spinning.
+     */
+    void wait_for_work(std::chrono::milliseconds max_wait);
+
     /**
      * Shutdown CEF.
      * Must be called from the main thread.
@@ -77,11 +98,34 @@ public:
      * Thread-safe.
      */
     void resize(int width, int height);
+
+    /**
+     * Change the windowless paint rate at runtime (render throttling).
+     * Thread-safe.
+     */
+    void set_frame_rate(int fps);
     
     /**
      * Get the current URL.
      */
     std::string current_url() const;
+
+    /**
+     * Paint-interval percentile histogram of the primary browser
+     * (nullptr before initialization).
+     */
+    const LatencyHistogram* paint_histogram() const {
+        return handler_ ? &handler_->paint_histogram() : nullptr;
+    }
+
+    /**
+     * Zero the primary browser's paint-interval histogram.
+     */
+    void reset_paint_histogram() {
+        if (handler_) {
+            handler_->reset_paint_histogram();
+        }
+    }
     
     /**
      * Check if CEF is initialized.
@@ -92,20 +136,69 @@ public:
      * Clear browser cache.
      */
     void clear_cache();
-    
+
     /**
      * Send memory pressure notification to CEF.
      */
     void notify_memory_pressure();
 
+    /**
+     * Create an additional off-screen browser sharing the CEF instance set
+     * up by initialize(). Chromium's process tree exists only once, so each
+     * extra browser costs tens of megabytes instead of a full CEF spawn.
+     * Must be called on the main thread after initialize().
+     * @param url Initial URL to load
+     * @param width Viewport width
+     * @param height Viewport height
+     * @param frame_callback Callback for rendered frames
+     * @return Stream id for the per-stream accessors, or -1 on failure
+     */
+    int create_stream(const std::string& url, int width, int height,
+                      FrameCallback frame_callback);
+
+    /**
+     * Navigate an additional stream's browser to a URL.
+     * Thread-safe.
+     */
+    void load_url(int stream_id, const std::string& url);
+
+    /**
+     * Reload an additional stream's page.
+     * Thread-safe.
+     */
+    void reload(int stream_id);
+
+    /**
+     * Get an additional stream's current URL.
+     */
+    std::string current_url(int stream_id) const;
+
 private:
+    // Shared browser-creation path for the primary and stream browsers
+    bool create_browser(CefRefPtr<CefHandler> handler, const std::string& url,
+                        int frame_rate);
+
+    // External pump: called from OnScheduleMessagePumpWork (any thread)
+    void schedule_pump_work(int64_t delay_ms);
+
     Config config_;
     FrameCallback frame_callback_;
-    
+    AudioStartedCallback audio_started_callback_;
+    AudioPacketCallback audio_packet_callback_;
+    AudioStoppedCallback audio_stopped_callback_;
+
     CefRefPtr<CefHandler> handler_;
-    
+    std::vector<CefRefPtr<CefHandler>> stream_handlers_;
+
     std::atomic<bool> initialized_{false};
     std::atomic<bool> shutdown_requested_{false};
+
+    // External message pump scheduling state
+    std::mutex pump_mutex_;
+    std::condition_variable pump_cv_;
+    std::chrono::steady_clock::time_point next_work_time_{
+        std::chrono::steady_clock::time_point::max()};
+    bool work_immediate_{false};
 };
 
 } // namespace html2ndi
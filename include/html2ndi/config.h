@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace html2ndi {
 
@@ -15,37 +16,80 @@ struct Config {
     std::string url = "about:blank";
     uint32_t width = 1920;
     uint32_t height = 1080;
-    uint32_t fps = 60;
+    uint32_t fps = 60;  // Rounded rate, kept for consumers needing an integer
+    int fps_n = 60;     // Rational framerate numerator (e.g. 60000 for 59.94)
+    int fps_d = 1;      // Rational framerate denominator (e.g. 1001 for 59.94)
     bool progressive = true;  // true = progressive (p), false = interlaced (i)
+    uint32_t idle_fps = 0;    // Keepalive rate while content is static (0 = full rate)
     
     // NDI settings
     std::string ndi_name = "HTML2NDI";
     std::string ndi_groups = "";
     bool ndi_clock_video = true;
     bool ndi_clock_audio = true;
+    bool ndi_async_send = true;  // Use NDIlib_send_send_video_async_v2
+    std::string ndi_pixel_format = "bgra";  // bgra (4 bytes/px) or uyvy (2 bytes/px)
+    bool alpha = false;  // Transparent page background + BGRA output with alpha
+    bool audio = false;  // Capture page audio via CefAudioHandler and send to NDI
+    bool proxy = false;  // Secondary low-bandwidth ".proxy" NDI output for WAN monitoring
+    uint32_t proxy_width = 640;  // Downscale width for the proxy stream
+    uint32_t proxy_fps = 15;     // Proxy send rate
+    // Unwatched-source governor: drop the render and send rate when nobody
+    // is pulling the stream. "connections" throttles with zero receivers,
+    // "tally" also throttles receivers that are neither on program nor
+    // preview (multiviewers keep a connection open but no tally).
+    std::string throttle_mode = "off";  // off, connections, tally
+    uint32_t throttle_fps = 5;          // Rate while throttled
     
+    // Additional NDI stream hosted by the same CEF instance (multi-stream
+    // mode). Geometry, framerate and pixel format are inherited from the
+    // primary settings above.
+    struct StreamConfig {
+        std::string ndi_name;
+        std::string url;
+    };
+    std::vector<StreamConfig> streams;  // Extra streams beyond the primary
+
     // Genlock settings
     std::string genlock_mode = "disabled";  // disabled, master, slave
     std::string genlock_master_addr = "127.0.0.1:5960";  // Master address for slave mode
+    int genlock_phase_us = -1;  // Sub-frame send-slot offset; -1 = automatic stagger
     
+    // Shared-memory preview (zero-copy transport for a local supervisor)
+    bool shm_preview = false;
+    uint32_t shm_preview_width = 640;  // Downscale width for published frames
+    uint32_t shm_preview_fps = 30;     // Maximum publish rate
+
     // HTTP server settings
     bool http_enabled = true;
     std::string http_host = "127.0.0.1";
     uint16_t http_port = 8080;
+    uint32_t status_interval_ms = 250;  // Snapshot refresh rate for GET /status (0 = per request)
     
     // CEF settings
     std::string cef_cache_path = "";
     bool cef_disable_gpu = false;
+    bool cef_shared_textures = false;  // Accelerated OSR via OnAcceleratedPaint/IOSurface
     std::string cef_user_agent = "";
     int cef_log_severity = 2; // WARNING
     
     // Application settings
+    std::string config_file = "";  // JSON file watched for hot reloads
     std::string log_file = "";
     int log_level = 1; // INFO
+    bool log_async = false;  // Buffer output through a background drain thread
     bool daemon_mode = false;
+    bool prewarm = false;  // Warm spare: init CEF on about:blank, defer NDI until POST /activate
+    bool test_pattern = false;  // Generate a procedural test pattern instead of rendering a page (no CEF)
+    uint32_t stall_threshold_ms = 200;  // Heartbeat gap that triggers backtrace capture (0 = off)
     
     // Parse command line arguments
     static std::optional<Config> parse(int argc, char* argv[]);
+
+    // Parse a framerate string into a rational {num, den}. Accepts integers
+    // ("60"), NTSC decimals ("59.94", "29.97", "23.976") and explicit
+    // rationals ("60000/1001"). Returns false on malformed input.
+    static bool parse_framerate(const std::string& str, int& num, int& den);
     
     // Print help message
     static void print_help(const char* program_name);
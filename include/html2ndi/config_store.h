@@ -0,0 +1,120 @@
+#pragma once
+
+#include "html2ndi/config.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace html2ndi {
+
+/**
+ * Atomically swappable immutable configuration snapshot (RCU pattern).
+ *
+ * Readers call snapshot() and get a shared_ptr to an immutable Config;
+ * the load is wait-free and never blocks a writer. Writers build a new
+ * Config and publish() it, which swaps the pointer and bumps the
+ * generation counter; readers holding the old snapshot keep a valid
+ * object until their shared_ptr drops.
+ *
+ * The store can also watch a JSON config file and republish when it
+ * changes, so runtime settings reach a live worker without a restart
+ * (restarting means seconds of black on air). Only fields that are safe
+ * to change mid-stream are applied from the file; geometry and NDI
+ * identity still require a restart.
+ */
+class ConfigStore {
+public:
+    /**
+     * Called after a new snapshot is published from the watched file.
+     * Runs on the watcher thread; the callback pushes changed values
+     * into the affected subsystems.
+     */
+    using ChangeCallback =
+        std::function<void(const Config& previous, const Config& current)>;
+
+    /**
+     * Create a store seeded with the startup configuration.
+     */
+    explicit ConfigStore(Config initial);
+    ~ConfigStore();
+
+    // Non-copyable
+    ConfigStore(const ConfigStore&) = delete;
+    ConfigStore& operator=(const ConfigStore&) = delete;
+
+    /**
+     * Get the current immutable snapshot. Wait-free; safe to call from
+     * the frame path.
+     */
+    std::shared_ptr<const Config> snapshot() const;
+
+    /**
+     * Publish a new snapshot. The previous snapshot stays valid for
+     * readers that already hold it.
+     */
+    void publish(Config next);
+
+    /**
+     * Get the snapshot generation (bumped on every publish).
+     */
+    uint64_t generation() const { return generation_; }
+
+    /**
+     * Get the number of successful file reloads.
+     */
+    uint64_t reload_count() const { return reload_count_; }
+
+    /**
+     * Set the callback invoked after a file-triggered publish.
+     */
+    void set_change_callback(ChangeCallback callback);
+
+    /**
+     * Start watching a JSON config file, republishing on change.
+     * @param path File to watch (need not exist yet)
+     * @return true if the watcher thread started
+     */
+    bool watch_file(const std::string& path);
+
+    /**
+     * Stop the file watcher thread.
+     */
+    void stop_watching();
+
+    /**
+     * Get the watched file path (empty when not watching).
+     */
+    const std::string& watched_file() const { return watch_path_; }
+
+    /**
+     * Apply the hot-reloadable subset of a JSON document onto a config.
+     * Recognized keys: url, idle_fps, log_level, stall_threshold_ms,
+     * status_interval_ms. Unknown keys are ignored with a warning.
+     * @param json_text JSON object text
+     * @param config Config to update in place
+     * @param error Set to a description on parse failure
+     * @return true if the document parsed and applied cleanly
+     */
+    static bool apply_json_overrides(const std::string& json_text,
+                                     Config& config, std::string& error);
+
+private:
+    void watcher_thread();
+
+    // RCU slot: writers swap the pointer via std::atomic_store, readers
+    // load it via std::atomic_load without taking any lock
+    std::shared_ptr<const Config> snapshot_;
+    std::atomic<uint64_t> generation_{1};
+    std::atomic<uint64_t> reload_count_{0};
+
+    ChangeCallback change_callback_;
+
+    std::string watch_path_;
+    std::atomic<bool> watching_{false};
+    std::thread watch_thread_;
+};
+
+} // namespace html2ndi
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+namespace html2ndi {
+
+/**
+ * Rectangle describing a region of a frame that changed.
+ * Mirrors CefRect so the NDI layer can consume dirty regions
+ * without pulling CEF headers into its translation units.
+ */
+struct FrameRect {
+    int x{0};
+    int y{0};
+    int width{0};
+    int height{0};
+};
+
+using FrameRectList = std::vector<FrameRect>;
+
+} // namespace html2ndi
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace html2ndi {
+
+/**
+ * Fan-out hub for the GET /events server-sent-events channel.
+ *
+ * Publishers (the main loop, the HTTP handlers) hand in named events with
+ * a JSON payload; every subscribed client gets its own bounded queue that
+ * drops the oldest entry when full, so one stalled dashboard connection
+ * can never apply backpressure to the frame path or to other clients.
+ * Pushing deltas replaces the Manager's 4-per-second /status polling and
+ * puts tally transitions on the wire within one main-loop tick.
+ */
+class EventStream {
+public:
+    /**
+     * One subscriber's queue. Owned jointly by the hub and the HTTP
+     * connection so teardown order does not matter.
+     */
+    struct Client {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::string> queue;  // Fully formatted SSE frames
+        uint64_t dropped{0};            // Events evicted by drop-oldest
+        bool closed{false};
+    };
+
+    /** Queue depth per client before drop-oldest kicks in. */
+    static constexpr size_t kQueueLimit = 64;
+
+    /**
+     * Register a new subscriber. The returned client already holds a
+     * "hello" event so the dashboard sees traffic immediately.
+     */
+    std::shared_ptr<Client> subscribe();
+
+    /**
+     * Remove a subscriber (its blocked wait, if any, is woken).
+     */
+    void unsubscribe(const std::shared_ptr<Client>& client);
+
+    /**
+     * Broadcast an event to every subscriber.
+     * @param event SSE event name (e.g. "tally")
+     * @param json_data Payload, already JSON-formatted
+     */
+    void publish(const std::string& event, const std::string& json_data);
+
+    /**
+     * Block until the client has an event queued, the stream shuts down,
+     * or the timeout passes (the caller then writes a keepalive comment).
+     * @return true with the next SSE frame in out, false on timeout/close
+     */
+    bool next(Client& client, std::string& out,
+              std::chrono::milliseconds timeout);
+
+    /**
+     * Wake and close every subscriber (server shutdown).
+     */
+    void shutdown();
+
+    // Statistics
+    size_t client_count() const;
+    uint64_t events_published() const { return events_published_; }
+    uint64_t events_dropped() const { return events_dropped_; }
+
+private:
+    void enqueue(Client& client, const std::string& frame);
+
+    mutable std::mutex clients_mutex_;
+    std::vector<std::shared_ptr<Client>> clients_;
+
+    std::atomic<bool> shutdown_{false};
+    std::atomic<uint64_t> events_published_{0};
+    std::atomic<uint64_t> events_dropped_{0};
+};
+
+} // namespace html2ndi
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -58,14 +59,39 @@ public:
 
 private:
     void setup_routes();
-    
+
+    /**
+     * Build and serialize the full status document. Touches the NDI SDK
+     * and pump atomics, so callers on the request path should prefer the
+     * cached snapshot.
+     */
+    std::string build_status_json();
+
+    /**
+     * Background loop that refreshes the pre-serialized status snapshot
+     * on the configured interval.
+     */
+    void snapshot_loop();
+
+    /**
+     * Get the cached status snapshot, refreshing synchronously if the
+     * snapshot thread has not produced one yet.
+     */
+    std::shared_ptr<const std::string> status_snapshot();
+
     Application* app_;
     std::string host_;
     uint16_t port_;
-    
+
     std::unique_ptr<httplib::Server> server_;
     std::thread server_thread_;
     std::atomic<bool> running_{false};
+
+    // Pre-serialized GET /status response, refreshed off the request path
+    std::thread snapshot_thread_;
+    std::atomic<bool> snapshot_running_{false};
+    std::mutex snapshot_mutex_;
+    std::shared_ptr<const std::string> snapshot_;
 };
 
 } // namespace html2ndi
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace html2ndi {
+
+/**
+ * Audio pump bridging CEF's audio capture thread and the NDI sender.
+ *
+ * CEF delivers planar float PCM in small packets on its own audio thread;
+ * NDI wants larger planar chunks at a steady cadence. The pump interleaves
+ * packets into a single-producer/single-consumer ring (wait-free on the
+ * producer side, so capture can never stall rendering) and a drain thread
+ * running at the video frame cadence de-interleaves and hands the queued
+ * samples to the sink. When the ring is full, samples are dropped and
+ * counted rather than blocking the CEF audio thread.
+ */
+class AudioPump {
+public:
+    /**
+     * Sink for drained audio, matching NdiSender::send_audio_frame.
+     * @param data Planar float samples (channel_stride = samples)
+     * @param sample_rate Sample rate in Hz
+     * @param channels Number of channels
+     * @param samples Number of samples per channel
+     */
+    using AudioSink = std::function<void(const float* data, int sample_rate,
+                                         int channels, int samples)>;
+
+    /**
+     * Create an audio pump.
+     * @param sink Destination for drained audio
+     * @param fps_n Video framerate numerator (sets the drain cadence)
+     * @param fps_d Video framerate denominator
+     */
+    AudioPump(AudioSink sink, int fps_n, int fps_d);
+    ~AudioPump();
+
+    // Non-copyable, non-movable
+    AudioPump(const AudioPump&) = delete;
+    AudioPump& operator=(const AudioPump&) = delete;
+
+    /**
+     * Start the drain thread. Idles until a stream is configured.
+     */
+    void start();
+
+    /**
+     * Stop the drain thread.
+     */
+    void stop();
+
+    /**
+     * Configure for a new audio stream. Sizes the ring and the drain
+     * scratch buffer, so the packet path never allocates. Called from
+     * CEF's OnAudioStreamStarted (UI thread).
+     * @param sample_rate Sample rate in Hz
+     * @param channels Number of channels
+     */
+    void on_stream_started(int sample_rate, int channels);
+
+    /**
+     * Push one captured packet into the ring. Wait-free: called from
+     * CEF's dedicated audio thread, never blocks or allocates. Samples
+     * that do not fit are dropped and counted.
+     * @param data Planar float samples, one pointer per channel
+     * @param frames Number of samples per channel
+     */
+    void push_packet(const float** data, int frames);
+
+    /**
+     * Mark the stream stopped. Remaining queued samples are drained.
+     */
+    void on_stream_stopped();
+
+    // Capture statistics
+    bool stream_active() const { return stream_active_; }
+    int sample_rate() const { return sample_rate_; }
+    int channels() const { return channels_; }
+    uint64_t packets_received() const { return packets_received_; }
+    uint64_t frames_sent() const { return frames_sent_; }
+    uint64_t frames_dropped() const { return frames_dropped_; }
+
+    /**
+     * Samples per channel currently queued in the ring.
+     */
+    uint64_t queued_frames() const;
+
+    /**
+     * Queued audio expressed as milliseconds of playout.
+     */
+    double queued_ms() const;
+
+    /**
+     * Smoothed audio-behind-video offset in milliseconds: how long a
+     * sample sits in the ring before it is handed to NDI, measured at
+     * each drain. Rising values mean the drain cadence is not keeping
+     * up with capture.
+     */
+    double av_offset_ms() const { return av_offset_ms_; }
+
+private:
+    void drain_thread();
+    void drain_available();
+
+    AudioSink sink_;
+    std::chrono::microseconds drain_interval_;
+
+    // Ring of interleaved frames (one frame = channels_ samples). Indices
+    // count frames monotonically; masking maps them into the buffer.
+    // Producer writes tail_, consumer writes head_ - classic SPSC.
+    std::vector<float> ring_;
+    uint64_t ring_capacity_{0};  // Frames, power of two
+    uint64_t ring_mask_{0};
+    std::atomic<uint64_t> head_{0};  // Next frame to drain (consumer)
+    std::atomic<uint64_t> tail_{0};  // Next frame to write (producer)
+
+    // Planar scratch for de-interleaving at drain time (consumer only)
+    std::vector<float> planar_scratch_;
+
+    // Stream parameters, fixed between on_stream_started/stopped
+    std::atomic<bool> stream_active_{false};
+    std::atomic<int> sample_rate_{0};
+    std::atomic<int> channels_{0};
+
+    // Serializes (re)configuration against the drain tick; the packet
+    // path deliberately never takes this
+    std::mutex drain_mutex_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    // Statistics
+    std::atomic<uint64_t> packets_received_{0};
+    std::atomic<uint64_t> frames_sent_{0};
+    std::atomic<uint64_t> frames_dropped_{0};
+    std::atomic<double> av_offset_ms_{0.0};
+};
+
+} // namespace html2ndi
@@ -0,0 +1,46 @@
+#pragma once
+
+namespace html2ndi {
+
+/**
+ * Color space configuration for NDI output.
+ */
+enum class ColorSpace {
+    Rec709,      // BT.709 (HD standard)
+    Rec2020,     // BT.2020 (UHD/HDR)
+    sRGB,        // sRGB (web standard)
+    Rec601       // BT.601 (SD legacy)
+};
+
+enum class GammaMode {
+    BT709,       // Standard broadcast gamma
+    BT2020,      // HDR gamma
+    sRGB,        // sRGB gamma (~2.2)
+    Linear       // Linear (1.0)
+};
+
+enum class ColorRange {
+    Full,        // 0-255 (PC/web)
+    Limited      // 16-235 (broadcast)
+};
+
+/**
+ * Pixel format for NDI output.
+ */
+enum class PixelFormat {
+    BGRX,        // 4 bytes/pixel, no conversion (CEF native)
+    UYVY,        // 2 bytes/pixel, converted on our side
+    BGRA         // 4 bytes/pixel, alpha channel carried to receivers
+};
+
+/**
+ * Alpha channel encoding for BGRA output.
+ * CEF renders premultiplied alpha; straight output runs an
+ * unpremultiply pass on our side before transmission.
+ */
+enum class AlphaMode {
+    Premultiplied,
+    Straight
+};
+
+} // namespace html2ndi
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "html2ndi/frame_rect.h"
 #include "html2ndi/ndi/ndi_sender.h"
 #include "html2ndi/ndi/genlock.h"
+#include "html2ndi/utils/latency_histogram.h"
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -35,6 +38,35 @@ public:
     FramePump(const FramePump&) = delete;
     FramePump& operator=(const FramePump&) = delete;
     
+    /**
+     * Pre-allocate the frame buffer pool for the expected output size.
+     * Call once at startup so the steady-state frame path never allocates;
+     * runtime resizes grow the pool on demand (it never shrinks).
+     * @param width Expected frame width
+     * @param height Expected frame height
+     */
+    void preallocate(int width, int height);
+
+    /**
+     * Stage a runtime resolution change. Pre-allocates pinned storage for
+     * the new frame size off the frame path, so when the first new-size
+     * frame arrives submit_frame swaps it in with an O(1) pointer exchange
+     * instead of reallocating mid-stream. Until that frame lands the pump
+     * keeps repeating the last old-size frame, and the output dimensions
+     * flip atomically on a frame boundary - no black frames, no drops.
+     * Safe to call from any thread.
+     * @param width New frame width
+     * @param height New frame height
+     */
+    void prepare_resize(int width, int height);
+
+    /**
+     * True while a staged resize is waiting for its first new-size frame.
+     */
+    bool resize_pending() const {
+        return pending_resize_width_.load() != 0;
+    }
+
     /**
      * Start the frame pump thread.
      */
@@ -48,17 +80,41 @@ public:
     /**
      * Submit a new frame from CEF.
      * Thread-safe.
+     * When dirty rectangles are provided and only a small portion of the
+     * frame changed, only the affected rows are copied into the back buffer.
+     * An empty list means the entire frame is copied.
      * @param data RGBA pixel data
      * @param width Frame width
      * @param height Frame height
+     * @param dirty_rects Regions of the frame that changed (may be empty)
      */
-    void submit_frame(const void* data, int width, int height);
+    void submit_frame(const void* data, int width, int height,
+                      const FrameRectList& dirty_rects = {});
     
     /**
      * Set the target framerate.
      * @param fps Target frames per second
      */
     void set_target_fps(int fps);
+
+    /**
+     * Set a rational target framerate (e.g. 60000/1001 for 59.94).
+     * The scheduler uses exact integer arithmetic on {num, den}, so
+     * fractional broadcast rates do not drift.
+     * @param num Framerate numerator
+     * @param den Framerate denominator
+     */
+    void set_target_fps(int num, int den);
+
+    /**
+     * Get the target framerate numerator.
+     */
+    int target_fps_n() const { return target_fps_n_; }
+
+    /**
+     * Get the target framerate denominator.
+     */
+    int target_fps_d() const { return target_fps_d_; }
     
     /**
      * Get the actual framerate.
@@ -70,7 +126,13 @@ public:
      * Get the number of frames sent.
      */
     uint64_t frames_sent() const { return frames_sent_; }
-    
+
+    /**
+     * Get the number of interlaced fields sent (0 in progressive mode).
+     * Two fields complete one frame, so this runs at 2x frames_sent().
+     */
+    uint64_t fields_sent() const { return fields_sent_; }
+
     /**
      * Get the number of frames dropped (truly unavailable).
      */
@@ -80,6 +142,12 @@ public:
      * Get the number of frames held (repeated during content changes).
      */
     uint64_t frames_held() const { return frames_held_; }
+
+    /**
+     * Get the number of ticks skipped because no receiver was connected
+     * (zero-receiver transmit suspension).
+     */
+    uint64_t frames_suspended() const { return frames_suspended_; }
     
     /**
      * Get uptime in seconds.
@@ -121,41 +189,235 @@ public:
      * Get current frame buffer size in bytes.
      */
     size_t current_buffer_size() const;
+
+    /**
+     * Get the total bytes held by the frame buffer pool.
+     */
+    size_t pool_bytes() const { return pool_bytes_; }
     
     /**
      * Get average frame submit time in microseconds.
      */
-    double avg_submit_time_us() const { return avg_submit_time_us_; }
-    
+    double avg_submit_time_us() const { return submit_histogram_.mean(); }
+
+    /**
+     * Get average memcpy time in microseconds (full and partial combined).
+     */
+    double avg_memcpy_time_us() const { return memcpy_histogram_.mean(); }
+
+    /**
+     * Percentile histograms (microseconds) for the frame-path timings.
+     * Unlike the averages above, these keep the tail: a 3 ms p999 submit
+     * spike survives a million 180 us submits.
+     */
+    const LatencyHistogram& submit_histogram() const { return submit_histogram_; }
+    const LatencyHistogram& memcpy_histogram() const { return memcpy_histogram_; }
+    const LatencyHistogram& wakeup_histogram() const { return wakeup_histogram_; }
+
+    /**
+     * End-to-end pipeline latency (microseconds): OnPaint handing pixels
+     * to submit_frame until send_video_frame ships them. Held/repeated
+     * frames are not recorded - only each frame's first transmission.
+     */
+    const LatencyHistogram& pipeline_histogram() const { return pipeline_histogram_; }
+
+    /**
+     * Paint-to-send latency of the most recently transmitted new frame,
+     * in microseconds.
+     */
+    int64_t last_pipeline_latency_us() const { return last_pipeline_latency_us_; }
+
+    /**
+     * Zero the percentile histograms (operator-triggered via the API).
+     */
+    void reset_latency_histograms() {
+        submit_histogram_.reset();
+        memcpy_histogram_.reset();
+        wakeup_histogram_.reset();
+        pipeline_histogram_.reset();
+    }
+
+    /**
+     * Get the frame generation counter.
+     * Bumped once per submitted frame; lets consumers (thumbnail cache)
+     * detect that content has not changed without touching pixel data.
+     */
+    uint64_t frame_generation() const { return frame_generation_; }
+
+    /**
+     * Get the content generation counter.
+     * Unlike frame_generation(), this only bumps when the frame content
+     * hash actually changes, so thumbnail/preview consumers can skip
+     * re-encoding frames that CEF repainted with identical pixels.
+     */
+    uint64_t content_generation() const { return content_generation_; }
+
+    /**
+     * Get the 64-bit content hash of the most recently submitted frame.
+     */
+    uint64_t content_hash() const { return content_hash_; }
+
+    /**
+     * Get the number of submits discarded because the repaint was
+     * pixel-identical to the current content (copy and publish skipped).
+     */
+    uint64_t duplicate_frames() const { return duplicate_frames_; }
+
+    /**
+     * Get the number of pump ticks suppressed by the idle keepalive policy.
+     */
+    uint64_t frames_idle_skipped() const { return frames_idle_skipped_; }
+
+    /**
+     * Set the idle keepalive rate. Once content has been static for over a
+     * second, the held frame is re-sent at this rate instead of the full
+     * target rate; a fresh frame exits idle immediately. 0 disables the
+     * policy (held frames always go out at the target rate).
+     * @param fps Keepalive frames per second (0 = disabled)
+     */
+    void set_idle_fps(int fps);
+
+    /**
+     * Get the idle keepalive rate (0 = disabled).
+     */
+    int idle_fps() const { return idle_fps_; }
+
+    /**
+     * Get average full-frame copy time in microseconds.
+     */
+    double avg_full_copy_time_us() const { return avg_full_copy_time_us_; }
+
+    /**
+     * Get average dirty-rect (partial) copy time in microseconds.
+     */
+    double avg_partial_copy_time_us() const { return avg_partial_copy_time_us_; }
+
+    /**
+     * Get the number of full-frame copies performed.
+     */
+    uint64_t full_copy_count() const { return full_copy_count_; }
+
+    /**
+     * Get the number of dirty-rect (partial) copies performed.
+     */
+    uint64_t partial_copy_count() const { return partial_copy_count_; }
+
+    /** Number of scheduling jitter histogram buckets. */
+    static constexpr int kJitterBuckets = 8;
+
+    /**
+     * Get average scheduling jitter (wakeup lateness) in microseconds.
+     */
+    double avg_jitter_us() const { return wakeup_histogram_.mean(); }
+
+    /**
+     * Get the worst scheduling jitter seen, in microseconds.
+     */
+    int64_t max_jitter_us() const {
+        return static_cast<int64_t>(wakeup_histogram_.max());
+    }
+
     /**
-     * Get average memcpy time in microseconds.
+     * Get the scheduling jitter histogram.
+     * Bucket i counts wakeups with lateness below jitter_bucket_bounds_us()[i];
+     * the last bucket is unbounded.
      */
-    double avg_memcpy_time_us() const { return avg_memcpy_time_us_; }
+    std::array<uint64_t, kJitterBuckets> jitter_histogram() const;
+
+    /**
+     * Get the upper bounds (microseconds) of the histogram buckets.
+     */
+    static const std::array<int64_t, kJitterBuckets - 1>& jitter_bucket_bounds_us();
 
 private:
     void pump_thread();
     void update_fps_counter();
     std::chrono::steady_clock::time_point get_current_time() const;
+    void wait_until_deadline(std::chrono::steady_clock::time_point deadline);
+    void record_jitter(std::chrono::nanoseconds lateness);
     
     NdiSender* sender_;
     std::shared_ptr<GenlockClock> genlock_clock_;
     
-    std::atomic<int> target_fps_;
+    std::atomic<int> target_fps_n_;
+    std::atomic<int> target_fps_d_;
     std::atomic<bool> progressive_;
     std::chrono::nanoseconds frame_duration_;
-    
-    // Double buffering
+
+    // Field extraction scratch for interlaced output (pump thread only)
+    std::vector<uint8_t> field_scratch_;
+
+    // Inclusive-exclusive range of rows [top, bottom) touched by dirty rects
+    struct RowSpan {
+        int top{0};
+        int bottom{0};
+    };
+
+    // Page-aligned, mlock-pinned frame storage. Sized on demand from the
+    // configured resolution instead of a fixed 4K reserve; capacity only
+    // ever grows, so a runtime resize reallocates at most once.
+    class FrameStorage {
+    public:
+        FrameStorage() = default;
+        ~FrameStorage();
+
+        FrameStorage(const FrameStorage&) = delete;
+        FrameStorage& operator=(const FrameStorage&) = delete;
+
+        uint8_t* data() { return data_; }
+        const uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+        size_t capacity() const { return capacity_; }
+        bool empty() const { return size_ == 0; }
+
+        // Grow-on-demand resize; existing contents are preserved
+        void resize(size_t bytes);
+
+        // Grow capacity without changing size; existing contents are
+        // preserved. Used to stage a resolution change off the frame path.
+        void reserve(size_t bytes);
+
+        // Exchange storage with another instance (pointer swap, O(1))
+        void swap(FrameStorage& other);
+
+    private:
+        uint8_t* data_{nullptr};
+        size_t size_{0};
+        size_t capacity_{0};
+    };
+
+    // Triple buffering: the writer (CEF UI thread) and reader (pump thread)
+    // exchange buffers through a single atomic and never block each other.
+    // Each buffer carries a seqlock version so the thumbnail path can detect
+    // a torn copy without putting a lock on the frame path.
     struct FrameBuffer {
-        std::vector<uint8_t> data;
+        FrameStorage data;
         int width{0};
         int height{0};
-        bool ready{false};
+        std::atomic<uint32_t> version{0}; // Seqlock: odd while the writer mutates
+        bool primed{false};               // Has held a complete frame at least once
+        std::vector<RowSpan> stale_rows;  // Rows updated in other buffers but not here yet
+        // When OnPaint handed these pixels to submit_frame; carried through
+        // to the send so paint-to-send latency is measurable per frame
+        std::chrono::steady_clock::time_point capture_time{};
     };
-    
-    FrameBuffer buffers_[2];
-    std::atomic<int> write_buffer_{0};
-    std::atomic<int> read_buffer_{1};
-    std::mutex buffer_mutex_;
+
+    // Sort and merge overlapping/adjacent row spans in place.
+    // Returns the total number of rows covered.
+    static int merge_row_spans(std::vector<RowSpan>& spans);
+
+    // shared_ holds the index of the buffer neither thread owns, with
+    // kFreshBit set while it contains a frame the reader has not consumed
+    static constexpr int kIndexMask = 0x3;
+    static constexpr int kFreshBit = 0x4;
+
+    FrameBuffer buffers_[3];
+    int write_index_{0};                       // Writer-private
+    int read_index_{2};                        // Reader-private
+    std::atomic<int> shared_{1};
+    std::atomic<int> read_index_published_{2}; // For thumbnail/stat readers
+    mutable std::mutex alloc_mutex_;           // Taken only on (rare) buffer reallocation
+    std::mutex wake_mutex_;                    // Backs buffer_cv_ only, never held over work
     std::condition_variable buffer_cv_;
     
     // Thread control
@@ -164,8 +426,10 @@ private:
     
     // Statistics
     std::atomic<uint64_t> frames_sent_{0};
+    std::atomic<uint64_t> fields_sent_{0};
     std::atomic<uint64_t> frames_dropped_{0};
     std::atomic<uint64_t> frames_held_{0};
+    std::atomic<uint64_t> frames_suspended_{0};
     std::chrono::steady_clock::time_point start_time_;
     
     // Current frame info for bandwidth calculation
@@ -178,8 +442,47 @@ private:
     std::atomic<float> measured_fps_{0.0f};
     
     // Performance metrics
-    std::atomic<double> avg_submit_time_us_{0.0};
-    std::atomic<double> avg_memcpy_time_us_{0.0};
+    std::atomic<double> avg_full_copy_time_us_{0.0};
+    std::atomic<double> avg_partial_copy_time_us_{0.0};
+
+    // Percentile histograms replacing the submit/memcpy/jitter EMAs;
+    // the avg_* accessors now report the histogram mean
+    LatencyHistogram submit_histogram_;
+    LatencyHistogram memcpy_histogram_;
+    LatencyHistogram wakeup_histogram_;
+    LatencyHistogram pipeline_histogram_;  // Paint-to-send, new frames only
+    std::atomic<int64_t> last_pipeline_latency_us_{0};
+    std::atomic<uint64_t> full_copy_count_{0};
+    std::atomic<uint64_t> partial_copy_count_{0};
+    std::atomic<uint64_t> frame_generation_{0};
+
+    // Content identity: per-row hashes XOR-fold into a frame hash, updated
+    // incrementally so a submit only hashes the rows its dirty rects touch.
+    // row_hashes_/frame_hash_/hashed_width_ are writer-private.
+    std::vector<uint64_t> row_hashes_;
+    uint64_t frame_hash_{0};
+    int hashed_width_{0};
+    std::atomic<uint64_t> content_hash_{0};
+    std::atomic<uint64_t> content_generation_{0};
+    std::atomic<uint64_t> duplicate_frames_{0};
+
+    // Idle keepalive policy (0 = disabled)
+    std::atomic<int> idle_fps_{0};
+    std::atomic<uint64_t> frames_idle_skipped_{0};
+
+    // Total capacity held by the three frame buffers
+    std::atomic<size_t> pool_bytes_{0};
+
+    // Staged resolution change: storage pre-grown by prepare_resize(),
+    // swapped into each buffer as the writer reaches it. Guarded by
+    // alloc_mutex_; pending dims are cleared when the first frame at the
+    // new size is published.
+    std::vector<std::unique_ptr<FrameStorage>> staged_storage_;
+    std::atomic<int> pending_resize_width_{0};
+    std::atomic<int> pending_resize_height_{0};
+
+    // Scheduling jitter (lateness of pump wakeups vs. absolute deadlines)
+    std::atomic<uint64_t> jitter_buckets_[kJitterBuckets]{};
 };
 
 } // namespace html2ndi
@@ -7,6 +7,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace html2ndi {
 
@@ -85,6 +86,26 @@ public:
      */
     int64_t get_ndi_timecode() const;
     
+    /**
+     * Set a sub-frame phase offset applied to every send slot.
+     *
+     * All genlocked streams aligning to the exact same boundary means all
+     * of them hand their frames to the NDI SDK in the same instant - on a
+     * loaded host that is a synchronized multi-hundred-megabyte transmit
+     * burst that overflows NIC queues. A phase offset shifts this
+     * stream's send slot within the frame interval while the timecode
+     * stays stamped against the un-shifted boundary, so staggered streams
+     * remain frame-locked on air. Calling this pins the offset and
+     * disables automatic stagger assignment.
+     * @param offset_us Offset in microseconds (folded into one frame)
+     */
+    void set_phase_offset_us(int64_t offset_us);
+
+    /**
+     * Get the current phase offset in microseconds.
+     */
+    int64_t phase_offset_us() const { return phase_offset_ns_.load() / 1000; }
+
     /**
      * Get sync status.
      */
@@ -149,6 +170,16 @@ private:
     
     // UDP socket for sync packets
     int socket_fd_{-1};
+
+    // Sub-frame send-slot offset; explicit (--genlock-phase-us or HTTP)
+    // wins over the master's automatic stagger assignment
+    std::atomic<int64_t> phase_offset_ns_{0};
+    std::atomic<bool> phase_explicit_{false};
+
+    // Master mode: slot index per slave endpoint, assigned in the order
+    // slaves first complete a delay exchange (master itself is slot 0)
+    mutable std::mutex slot_mutex_;
+    std::vector<uint64_t> slot_keys_;
     
     // Statistics
     std::atomic<uint64_t> packets_sent_{0};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "html2ndi/config.h"
+#include "html2ndi/ndi/color_types.h"
 #include <Processing.NDI.Lib.h>
 
 #include <atomic>
@@ -8,32 +9,11 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace html2ndi {
 
-/**
- * Color space configuration for NDI output.
- */
-enum class ColorSpace {
-    Rec709,      // BT.709 (HD standard)
-    Rec2020,     // BT.2020 (UHD/HDR)
-    sRGB,        // sRGB (web standard)
-    Rec601       // BT.601 (SD legacy)
-};
-
-enum class GammaMode {
-    BT709,       // Standard broadcast gamma
-    BT2020,      // HDR gamma
-    sRGB,        // sRGB gamma (~2.2)
-    Linear       // Linear (1.0)
-};
-
-enum class ColorRange {
-    Full,        // 0-255 (PC/web)
-    Limited      // 16-235 (broadcast)
-};
-
 /**
  * NDI sender wrapper.
  * Handles NDI initialization and frame transmission.
@@ -73,6 +53,9 @@ public:
      * @param frame_rate_n Framerate numerator
      * @param frame_rate_d Framerate denominator
      * @param progressive true for progressive, false for interlaced
+     * @param capture_timestamp Capture time in 100 ns UTC units, stamped
+     *        into the NDI frame so receivers see pipeline age rather than
+     *        send time (0 = let the SDK fill in the send time)
      */
     void send_video_frame(
         const uint8_t* data,
@@ -80,7 +63,30 @@ public:
         int height,
         int frame_rate_n,
         int frame_rate_d,
-        bool progressive = true);
+        bool progressive = true,
+        int64_t capture_timestamp = 0);
+
+    /**
+     * Send one interlaced field (NDIlib_frame_format_type_field_0/1).
+     * The buffer holds only the field's rows, tightly packed at half the
+     * frame height; the aspect ratio is stamped for the full frame so
+     * receivers display it correctly.
+     * @param data BGRA field data (field rows only)
+     * @param width Frame width
+     * @param field_height Rows in this field (frame height / 2)
+     * @param frame_rate_n Field rate numerator (2x the frame rate)
+     * @param frame_rate_d Field rate denominator
+     * @param top_field true for field 0 (even rows), false for field 1
+     * @param capture_timestamp Capture time in 100 ns UTC units (0 = SDK)
+     */
+    void send_video_field(
+        const uint8_t* data,
+        int width,
+        int field_height,
+        int frame_rate_n,
+        int frame_rate_d,
+        bool top_field,
+        int64_t capture_timestamp = 0);
     
     /**
      * Send an audio frame.
@@ -97,10 +103,26 @@ public:
     
     /**
      * Get the number of connected receivers.
-     * @param timeout_ms Timeout in milliseconds
+     * Served from the event thread's cache when called without a timeout,
+     * so per-tick polls never enter the SDK.
+     * @param timeout_ms Timeout in milliseconds (>0 queries the SDK)
      * @return Number of connections
      */
     int get_connection_count(uint32_t timeout_ms = 0) const;
+
+    /**
+     * Wait-free receiver check for the frame path. Maintained by the
+     * event thread; false means nobody is listening and sends can be
+     * suspended without touching the SDK or the send mutex.
+     */
+    bool has_receivers() const {
+        return connected_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Number of receiver metadata messages drained by the event thread.
+     */
+    uint64_t metadata_received() const { return metadata_received_; }
     
     /**
      * Tally state structure.
@@ -146,12 +168,53 @@ public:
     GammaMode gamma_mode() const { return gamma_mode_; }
     ColorRange color_range() const { return color_range_; }
     
+    /**
+     * Set the output pixel format.
+     * UYVY halves per-frame bandwidth (2 bytes/pixel) at the cost of a
+     * SIMD colorspace conversion on our side.
+     */
+    void set_pixel_format(PixelFormat format) { pixel_format_ = format; }
+
+    /**
+     * Get the current output pixel format.
+     */
+    PixelFormat pixel_format() const { return pixel_format_; }
+
+    /**
+     * Select how BGRA alpha is encoded on the wire. CEF renders
+     * premultiplied, so Premultiplied is a plain copy; Straight runs the
+     * unpremultiply kernel on our side before transmission. Only relevant
+     * when the pixel format is BGRA.
+     */
+    void set_alpha_mode(AlphaMode mode) { alpha_mode_ = mode; }
+
+    /**
+     * Get the current alpha encoding mode.
+     */
+    AlphaMode alpha_mode() const { return alpha_mode_; }
+
     /**
      * Get string representation of current settings.
      */
     std::string color_space_name() const;
     std::string gamma_mode_name() const;
     std::string color_range_name() const;
+    std::string pixel_format_name() const;
+    std::string alpha_mode_name() const;
+
+    /**
+     * Enable or disable asynchronous video transmission.
+     * In async mode frames are copied into a rotating set of owned buffers
+     * and handed to NDIlib_send_send_video_async_v2, so the caller only
+     * blocks for the copy instead of the full compress/transmit time.
+     * @param enabled true for async send, false for synchronous send
+     */
+    void set_async_send(bool enabled) { async_send_ = enabled; }
+
+    /**
+     * Check whether async transmission is enabled.
+     */
+    bool async_send() const { return async_send_; }
 
     /**
      * Set explicit timecode for next frame.
@@ -172,6 +235,21 @@ public:
 
 private:
     void update_metadata();
+
+    // Shared body of send_video_frame/send_video_field: format dispatch,
+    // conversion and the actual SDK send. display_height is the full
+    // frame height the aspect ratio is computed from (= height except for
+    // fields, where it is 2x the buffer height).
+    void send_video_internal(
+        const uint8_t* data,
+        int width,
+        int height,
+        int display_height,
+        int frame_rate_n,
+        int frame_rate_d,
+        NDIlib_frame_format_type_e frame_format,
+        int64_t capture_timestamp);
+
     std::string name_;
     std::string groups_;
     
@@ -183,6 +261,15 @@ private:
     // Video frame buffer (reused to avoid allocations)
     std::vector<uint8_t> video_buffer_;
     NDIlib_video_frame_v2_t video_frame_{};
+
+    // Async send: rotating buffers whose lifetime is handed to the NDI SDK.
+    // The SDK owns a buffer until the next async send call, so rotation
+    // guarantees we never overwrite a frame still being transmitted.
+    static constexpr int kAsyncBufferCount = 3;
+    std::vector<uint8_t> async_buffers_[kAsyncBufferCount];
+    int async_buffer_index_{0};
+    bool async_in_flight_{false};
+    std::atomic<bool> async_send_{true};
     
     // Audio frame buffer
     std::vector<float> audio_buffer_;
@@ -192,10 +279,25 @@ private:
     ColorSpace color_space_{ColorSpace::Rec709};
     GammaMode gamma_mode_{GammaMode::BT709};
     ColorRange color_range_{ColorRange::Full};
+    std::atomic<PixelFormat> pixel_format_{PixelFormat::BGRX};
+    std::atomic<AlphaMode> alpha_mode_{AlphaMode::Premultiplied};
     std::string color_metadata_;
     
     // Timecode control
     std::atomic<int64_t> next_timecode_{NDIlib_send_timecode_synthesize};
+
+    // Background NDI event thread: tracks connection count and tally and
+    // drains receiver metadata, so the frame path and the HTTP/governor
+    // pollers read cached atomics instead of entering the SDK per call
+    void event_thread();
+
+    std::thread event_thread_handle_;
+    std::atomic<bool> event_running_{false};
+    std::atomic<bool> connected_{false};
+    std::atomic<int> connection_count_{0};
+    std::atomic<bool> tally_program_{false};
+    std::atomic<bool> tally_preview_{false};
+    std::atomic<uint64_t> metadata_received_{0};
 };
 
 } // namespace html2ndi
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "html2ndi/frame_rect.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace html2ndi {
+
+/**
+ * Procedural test-pattern source that replaces CEF (--pattern mode).
+ *
+ * Generates color bars, a moving zone plate and a frame-counter burn-in
+ * straight into the frame pump at the target rate, so the NDI path can be
+ * benchmarked in isolation: any drop or jitter seen downstream is the
+ * pump/sender, not Chromium. Generation cost is small and constant
+ * (memcpy rows for the static bars, NEON-expanded grayscale for the zone
+ * plate), which also makes N pattern workers a clean capacity probe for
+ * a host's NDI throughput ceiling.
+ */
+class PatternGenerator {
+public:
+    /**
+     * Frame sink, signature-compatible with the CEF frame callback so
+     * the generator plugs into FramePump::submit_frame unchanged.
+     */
+    using SubmitCallback = std::function<void(const void* buffer, int width,
+                                              int height,
+                                              const FrameRectList& dirty_rects)>;
+
+    /**
+     * Create a pattern generator.
+     * @param width Frame width
+     * @param height Frame height
+     * @param fps_n Framerate numerator
+     * @param fps_d Framerate denominator
+     * @param submit Destination for generated frames
+     */
+    PatternGenerator(int width, int height, int fps_n, int fps_d,
+                     SubmitCallback submit);
+    ~PatternGenerator();
+
+    // Non-copyable, non-movable
+    PatternGenerator(const PatternGenerator&) = delete;
+    PatternGenerator& operator=(const PatternGenerator&) = delete;
+
+    /**
+     * Start the generator thread.
+     */
+    void start();
+
+    /**
+     * Stop the generator thread.
+     */
+    void stop();
+
+    /**
+     * Render one frame of the pattern into the internal buffer and submit
+     * it. Exposed for tests; the generator thread calls this per tick.
+     */
+    void generate_frame();
+
+    // Statistics
+    uint64_t frames_generated() const { return frames_generated_; }
+    double avg_generate_time_us() const { return avg_generate_time_us_; }
+
+private:
+    void generator_thread();
+    void render_bars();
+    void render_zone_plate(uint64_t frame);
+    void render_counter(uint64_t frame);
+
+    int width_;
+    int height_;
+    int fps_n_;
+    int fps_d_;
+    SubmitCallback submit_;
+
+    // BGRA frame under construction; bars are painted once, the dynamic
+    // bands are rewritten per frame
+    std::vector<uint8_t> frame_;
+    std::vector<uint32_t> x_squared_;  // Per-column x^2 for the zone plate
+    std::vector<uint8_t> gray_row_;    // Zone plate grayscale scratch
+
+    // Band layout (rows)
+    int bars_bottom_{0};
+    int plate_bottom_{0};
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> frames_generated_{0};
+    std::atomic<double> avg_generate_time_us_{0.0};
+};
+
+} // namespace html2ndi
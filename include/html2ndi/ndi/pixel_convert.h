@@ -0,0 +1,112 @@
+#pragma once
+
+#include "html2ndi/ndi/color_types.h"
+
+#include <cstdint>
+
+namespace html2ndi {
+
+/**
+ * Integer coefficients for BGRA->UYVY conversion, scaled by 256.
+ *
+ *   Y = ((yr*R + yg*G + yb*B + 128) >> 8) + y_offset
+ *   U = ((ub*B - ur*R - ug*G + 128) >> 8) + 128
+ *   V = ((vr*R - vg*G - vb*B + 128) >> 8) + 128
+ */
+struct UyvyCoefficients {
+    uint8_t yr{0}, yg{0}, yb{0};
+    int y_offset{0};
+    int16_t ur{0}, ug{0}, ub{0};
+    int16_t vr{0}, vg{0}, vb{0};
+};
+
+/**
+ * Resolve conversion coefficients for a colorspace/range combination.
+ * sRGB uses the BT.709 matrix (same primaries).
+ */
+UyvyCoefficients uyvy_coefficients(ColorSpace color_space, ColorRange color_range);
+
+/**
+ * Convert packed BGRA pixels to UYVY (4:2:2).
+ * NEON-vectorized on arm64 with a scalar fallback; chroma is averaged over
+ * each horizontal pixel pair.
+ * @param bgra Input BGRA pixel data
+ * @param width Frame width (odd trailing pixel duplicates its chroma)
+ * @param height Frame height
+ * @param color_space Colorimetry matrix to use
+ * @param color_range Full (0-255) or limited (16-235) output range
+ * @param out_uyvy Output buffer, width * height * 2 bytes
+ */
+void bgra_to_uyvy(const uint8_t* bgra, int width, int height,
+                  ColorSpace color_space, ColorRange color_range,
+                  uint8_t* out_uyvy);
+
+/**
+ * Premultiply BGRA color channels by alpha: c' = round(c * a / 255).
+ * NEON-vectorized on arm64 with a scalar fallback. In-place operation
+ * (bgra == out_bgra) is supported.
+ * @param bgra Input straight-alpha BGRA pixel data
+ * @param width Frame width
+ * @param height Frame height
+ * @param out_bgra Output buffer, width * height * 4 bytes
+ */
+void bgra_premultiply(const uint8_t* bgra, int width, int height,
+                      uint8_t* out_bgra);
+
+/**
+ * Convert premultiplied BGRA back to straight alpha: c' = round(c * 255 / a).
+ * Uses a 16.16 fixed-point reciprocal table, so the per-pixel cost is a
+ * multiply and shift rather than a division; fully transparent pixels map
+ * to zero. In-place operation is supported.
+ * @param bgra Input premultiplied BGRA pixel data
+ * @param width Frame width
+ * @param height Frame height
+ * @param out_bgra Output buffer, width * height * 4 bytes
+ */
+void bgra_unpremultiply(const uint8_t* bgra, int width, int height,
+                        uint8_t* out_bgra);
+
+/**
+ * Compress full-range BGRA/BGRX color channels to limited (video) range:
+ * c' = 16 + round(c * 219 / 255), so 0-255 maps onto 16-235. Alpha passes
+ * through untouched. NEON-vectorized on arm64 with a scalar fallback;
+ * in-place operation is supported. Fused into the sender's outgoing frame
+ * copy so the range transform costs no extra pass over the pixels.
+ * @param bgra Input full-range pixel data
+ * @param width Frame width
+ * @param height Frame height
+ * @param out_bgra Output buffer, width * height * 4 bytes
+ */
+void bgra_full_to_limited(const uint8_t* bgra, int width, int height,
+                          uint8_t* out_bgra);
+
+/**
+ * Expand limited (video) range BGRA/BGRX color channels back to full
+ * range: c' = clamp((c - 16) * 255 / 219). The inverse of
+ * bgra_full_to_limited up to rounding; sub-black and super-white inputs
+ * clamp. NEON-vectorized on arm64 with a scalar fallback; in-place
+ * operation is supported.
+ * @param bgra Input limited-range pixel data
+ * @param width Frame width
+ * @param height Frame height
+ * @param out_bgra Output buffer, width * height * 4 bytes
+ */
+void bgra_limited_to_full(const uint8_t* bgra, int width, int height,
+                          uint8_t* out_bgra);
+
+/**
+ * Extract one interlaced field from a progressive BGRA frame: every other
+ * row packed tightly into a half-height buffer. Field 0 is the top field
+ * (rows 0, 2, 4, ...), field 1 the bottom (rows 1, 3, 5, ...); an odd
+ * height gives the extra row to the top field. Each row is one memcpy,
+ * which already moves at full SIMD width.
+ * @param bgra Input progressive frame
+ * @param width Frame width
+ * @param height Progressive frame height
+ * @param top_field true for field 0, false for field 1
+ * @param out_field Output buffer, width * field rows * 4 bytes
+ */
+void bgra_extract_field(const uint8_t* bgra, int width, int height,
+                        bool top_field, uint8_t* out_field);
+
+} // namespace html2ndi
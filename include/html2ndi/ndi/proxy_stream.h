@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace html2ndi {
+
+class NdiSender;
+
+/**
+ * Low-bandwidth proxy NDI output for remote monitoring.
+ *
+ * Owns a second NdiSender (primary name + ".proxy") fed by the current
+ * program frame, box-downscaled to the proxy width (NEON-accumulated,
+ * shared with the thumbnail path) and sent at a reduced rate. A 480-wide
+ * 15 fps proxy is a few percent of the program stream's bandwidth, so a
+ * truck can monitor over a WAN link without pulling the full source.
+ * Unchanged content is re-sent only as a once-per-second keepalive.
+ */
+class ProxyStream {
+public:
+    /**
+     * Copy the current program frame.
+     * Same contract as FramePump::get_current_frame.
+     */
+    using FrameProvider = std::function<bool(std::vector<uint8_t>& data,
+                                             int& width, int& height)>;
+
+    /**
+     * Report the current content generation, so unchanged frames are not
+     * re-downscaled and re-sent at the full proxy rate.
+     */
+    using GenerationProvider = std::function<uint64_t()>;
+
+    /**
+     * Create a proxy stream.
+     * @param ndi_name Proxy source name (primary name + ".proxy")
+     * @param ndi_groups NDI groups (shared with the primary sender)
+     * @param proxy_width Width frames are downscaled to before sending
+     * @param proxy_fps Proxy send rate
+     * @param frame_provider Source of program frames
+     * @param generation_provider Source of the content generation counter
+     */
+    ProxyStream(std::string ndi_name, std::string ndi_groups,
+                int proxy_width, int proxy_fps,
+                FrameProvider frame_provider,
+                GenerationProvider generation_provider);
+    ~ProxyStream();
+
+    // Non-copyable
+    ProxyStream(const ProxyStream&) = delete;
+    ProxyStream& operator=(const ProxyStream&) = delete;
+
+    /**
+     * Create the proxy NDI sender.
+     * @return true if the sender is ready
+     */
+    bool initialize();
+
+    /**
+     * Start the proxy thread.
+     */
+    void start();
+
+    /**
+     * Stop the proxy thread and shut the sender down.
+     */
+    void stop();
+
+    // Statistics and settings
+    const std::string& name() const { return ndi_name_; }
+    int proxy_width() const { return proxy_width_; }
+    int proxy_fps() const { return proxy_fps_; }
+    uint64_t frames_sent() const { return frames_sent_; }
+    uint64_t frames_skipped() const { return frames_skipped_; }
+
+private:
+    void proxy_thread();
+
+    std::string ndi_name_;
+    std::string ndi_groups_;
+    int proxy_width_;
+    int proxy_fps_;
+    FrameProvider frame_provider_;
+    GenerationProvider generation_provider_;
+
+    std::unique_ptr<NdiSender> sender_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> frames_sent_{0};
+    std::atomic<uint64_t> frames_skipped_{0};  // Ticks with unchanged content
+};
+
+} // namespace html2ndi
@@ -27,8 +27,21 @@ bool encode_jpeg(const uint8_t* rgba_data, int width, int height, int quality,
  * @param out_jpeg Output JPEG data
  * @return true if encoding succeeded
  */
-bool encode_jpeg_scaled(const uint8_t* rgba_data, int width, int height, 
+bool encode_jpeg_scaled(const uint8_t* rgba_data, int width, int height,
                         int target_width, int quality, std::vector<uint8_t>& out_jpeg);
 
+/**
+ * Downscale BGRA data with an averaging box filter, keeping BGRA layout.
+ * Used to feed the hardware preview encoder at preview resolution.
+ * @param bgra_data Input BGRA pixel data
+ * @param width Input width
+ * @param height Input height
+ * @param out_bgra Output buffer (target_width * target_height * 4 bytes)
+ * @param target_width Target width (must be < width)
+ * @param target_height Target height (must be < height)
+ */
+void scale_bgra_box(const uint8_t* bgra_data, int width, int height,
+                    uint8_t* out_bgra, int target_width, int target_height);
+
 } // namespace html2ndi
 
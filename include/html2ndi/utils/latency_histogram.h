@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+namespace html2ndi {
+
+/**
+ * Fixed-memory log-bucketed latency histogram (HDR style).
+ *
+ * Values are binned into 16 linear sub-buckets per power of two, giving
+ * a worst-case relative error of ~6% over the whole range while the
+ * storage stays a couple of hundred atomic counters. record() is a single
+ * relaxed fetch-add on the hot path, so frame-path instrumentation costs
+ * the same as the moving averages it replaces - but the percentiles keep
+ * the tail spikes an average erases.
+ *
+ * Units are whatever the caller records (the pump uses microseconds).
+ * Thread-safe: any thread may record while another reads or resets.
+ */
+class LatencyHistogram {
+public:
+    /** Linear sub-buckets per power of two (as a bit count). */
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+
+    /** Values at or above 2^kMaxExponent clamp into the last bucket. */
+    static constexpr int kMaxExponent = 30;
+
+    static constexpr int kBucketCount =
+        kSubBuckets + (kMaxExponent - kSubBucketBits) * (kSubBuckets / 2);
+
+    /** Point-in-time digest for export. */
+    struct Summary {
+        uint64_t count{0};
+        uint64_t p50{0};
+        uint64_t p99{0};
+        uint64_t p999{0};
+        uint64_t max{0};
+    };
+
+    /**
+     * Record one sample. Lock-free and wait-free.
+     */
+    void record(uint64_t value) {
+        buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t seen = max_.load(std::memory_order_relaxed);
+        while (value > seen &&
+               !max_.compare_exchange_weak(seen, value,
+                                           std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    /**
+     * Arithmetic mean of all recorded samples (0 when empty).
+     */
+    double mean() const {
+        const uint64_t n = count_.load(std::memory_order_relaxed);
+        if (n == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(sum_.load(std::memory_order_relaxed)) / n;
+    }
+
+    /**
+     * Value at the given percentile (0-100), reported as the upper bound
+     * of the bucket holding that rank, so it never under-states latency.
+     */
+    uint64_t percentile(double p) const {
+        const uint64_t total = count_.load(std::memory_order_relaxed);
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * total + 0.5);
+        if (rank < 1) {
+            rank = 1;
+        }
+
+        uint64_t cumulative = 0;
+        for (int i = 0; i < kBucketCount; i++) {
+            cumulative += buckets_[i].load(std::memory_order_relaxed);
+            if (cumulative >= rank) {
+                return bucket_upper_bound(i);
+            }
+        }
+        return bucket_upper_bound(kBucketCount - 1);
+    }
+
+    /**
+     * Digest with the percentiles /status exports.
+     */
+    Summary summary() const {
+        Summary s;
+        s.count = count();
+        s.p50 = percentile(50.0);
+        s.p99 = percentile(99.0);
+        s.p999 = percentile(99.9);
+        s.max = max();
+        return s;
+    }
+
+    /**
+     * Zero all counters. Samples recorded concurrently with a reset may
+     * land on either side of it; counts stay consistent enough for
+     * operator-triggered resets.
+     */
+    void reset() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static int bucket_index(uint64_t value) {
+        if (value < kSubBuckets) {
+            return static_cast<int>(value);
+        }
+        const uint64_t clamped =
+            std::min<uint64_t>(value, (uint64_t{1} << kMaxExponent) - 1);
+        // 2^exponent <= clamped < 2^(exponent+1)
+        const int exponent = std::bit_width(clamped) - 1;
+        const int shift = exponent - kSubBucketBits + 1;
+        const int sub = static_cast<int>((clamped >> shift) - kSubBuckets / 2);
+        return kSubBuckets +
+               (exponent - kSubBucketBits) * (kSubBuckets / 2) + sub;
+    }
+
+    static uint64_t bucket_upper_bound(int index) {
+        if (index < kSubBuckets) {
+            return static_cast<uint64_t>(index);
+        }
+        const int block = (index - kSubBuckets) / (kSubBuckets / 2);
+        const int sub = (index - kSubBuckets) % (kSubBuckets / 2);
+        const int shift = block + 1;
+        const uint64_t lower =
+            static_cast<uint64_t>(kSubBuckets / 2 + sub) << shift;
+        return lower + ((uint64_t{1} << shift) - 1);
+    }
+
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace html2ndi
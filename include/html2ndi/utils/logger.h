@@ -1,10 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <cstdarg>
 #include <fstream>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 
 #ifdef __APPLE__
 #include <os/log.h>
@@ -66,25 +68,58 @@ public:
     
     /**
      * Flush any buffered output.
+     * In async mode this waits for queued records to drain first.
      */
     void flush();
 
+    /**
+     * Enable or disable the asynchronous backend.
+     * When enabled, producers copy preformatted records into a lock-free
+     * MPSC ring and a drain thread performs the console/file/os_log
+     * writes, so frame-path callers never block on I/O. Records that
+     * arrive while the ring is full are counted and dropped.
+     */
+    void set_async(bool enabled);
+
+    /**
+     * Check whether the async backend is active.
+     */
+    bool async_enabled() const { return async_running_; }
+
+    /**
+     * Get the number of records dropped because the ring was full.
+     */
+    uint64_t dropped_records() const { return dropped_records_; }
+
 private:
     Logger();
     ~Logger();
-    
+
     // Non-copyable
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
-    
+
     void write_to_file(const std::string& message);
     void rotate_file_if_needed();
     void log_to_os(LogLevel level, const char* message);
-    
+
+    // Console/file/os_log output for one formatted line (takes mutex_)
+    void emit(LogLevel level, const char* line, const char* message);
+
+    void drain_loop();
+
     LogLevel level_{LogLevel::INFO};
     std::string file_path_;
     std::ofstream file_;
     std::mutex mutex_;
+
+    // Async backend (bounded MPSC ring, drained by a dedicated thread)
+    class LogRing;
+    std::unique_ptr<LogRing> ring_;
+    std::thread drain_thread_;
+    std::atomic<bool> async_running_{false};
+    std::atomic<uint64_t> dropped_records_{0};
+    uint64_t dropped_reported_{0};  // Drain thread only
     
     size_t max_file_size_{10 * 1024 * 1024}; // 10MB
     int max_files_{5};
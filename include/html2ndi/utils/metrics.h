@@ -0,0 +1,67 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace html2ndi {
+
+/**
+ * Process-wide metrics registry backing the Prometheus GET /metrics endpoint.
+ *
+ * Hot paths never touch the registry: subsystems keep updating their own
+ * std::atomic counters exactly as before, and register a sampler once at
+ * startup that reads those atomics when a scrape happens. The registry
+ * mutex therefore only serializes registration and scrapes, never the
+ * frame path.
+ */
+class MetricsRegistry {
+public:
+    enum class Type { Counter, Gauge };
+
+    /** Called on each scrape to read the current value. Must not block. */
+    using Sampler = std::function<double()>;
+
+    /**
+     * Get the process-wide registry.
+     */
+    static MetricsRegistry& instance();
+
+    /**
+     * Register a metric.
+     * Names follow Prometheus conventions (e.g. html2ndi_frames_sent_total).
+     * Re-registering an existing name replaces its sampler.
+     * @param name Metric name
+     * @param help One-line description for the # HELP comment
+     * @param type Counter or Gauge
+     * @param sampler Callback returning the current value
+     */
+    void register_metric(const std::string& name, const std::string& help,
+                         Type type, Sampler sampler);
+
+    /**
+     * Remove a metric by name. No-op if it is not registered.
+     */
+    void unregister_metric(const std::string& name);
+
+    /**
+     * Render all metrics in the Prometheus text exposition format.
+     */
+    std::string render() const;
+
+private:
+    MetricsRegistry() = default;
+
+    struct Metric {
+        std::string name;
+        std::string help;
+        Type type;
+        Sampler sampler;
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<Metric> metrics_;
+};
+
+} // namespace html2ndi
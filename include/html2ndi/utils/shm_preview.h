@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace html2ndi {
+
+/**
+ * Zero-copy preview transport over POSIX shared memory.
+ *
+ * Publishes the current output frame, downscaled to the preview width,
+ * into a named shm segment that a supervisor process maps read-only.
+ * The header carries a seqlock sequence (odd while the writer mutates)
+ * so readers detect torn frames without sharing a lock with the writer,
+ * eliminating both the JPEG encode and the HTTP round-trip of the
+ * /thumbnail path. The segment name is advertised in GET /status.
+ */
+class ShmPreview {
+public:
+    /**
+     * Layout of the start of the mapped segment.
+     * BGRA pixels (height rows of stride bytes) follow immediately after.
+     */
+    struct Header {
+        uint32_t magic;                  // kMagic ("H2NP")
+        uint32_t version;                // kVersion
+        std::atomic<uint64_t> sequence;  // Seqlock: odd while writer mutates
+        uint64_t frame_number;           // Bumped once per published frame
+        int32_t width;                   // Preview width in pixels
+        int32_t height;                  // Preview height in pixels
+        int32_t stride;                  // Bytes per row (width * 4)
+        int32_t reserved;
+        uint64_t timestamp_us;           // Steady-clock publish time
+    };
+
+    static constexpr uint32_t kMagic = 0x48324E50;
+    static constexpr uint32_t kVersion = 1;
+
+    /**
+     * Copy the current frame for publication.
+     * Same contract as FramePump::get_current_frame.
+     */
+    using FrameProvider = std::function<bool(std::vector<uint8_t>& data,
+                                             int& width, int& height)>;
+
+    /**
+     * Report the current content generation, so unchanged frames are not
+     * re-published.
+     */
+    using GenerationProvider = std::function<uint64_t()>;
+
+    /**
+     * Create a shared-memory preview publisher.
+     * @param name Segment name (must start with '/')
+     * @param preview_width Width frames are downscaled to before publishing
+     * @param publish_fps Maximum publish rate
+     * @param frame_provider Source of frames
+     * @param generation_provider Source of the content generation counter
+     */
+    ShmPreview(std::string name, int preview_width, int publish_fps,
+               FrameProvider frame_provider,
+               GenerationProvider generation_provider);
+    ~ShmPreview();
+
+    // Non-copyable
+    ShmPreview(const ShmPreview&) = delete;
+    ShmPreview& operator=(const ShmPreview&) = delete;
+
+    /**
+     * Create and map the shared-memory segment.
+     * @return true if the segment is ready for publishing
+     */
+    bool initialize();
+
+    /**
+     * Start the publisher thread.
+     */
+    void start();
+
+    /**
+     * Stop the publisher thread.
+     */
+    void stop();
+
+    /**
+     * Unmap and unlink the segment.
+     */
+    void shutdown();
+
+    /**
+     * Get the segment name (as passed to shm_open).
+     */
+    const std::string& name() const { return name_; }
+
+    /**
+     * Get the preview width.
+     */
+    int preview_width() const { return preview_width_; }
+
+    /**
+     * Get the publish rate.
+     */
+    int publish_fps() const { return publish_fps_; }
+
+    /**
+     * Get the number of frames published so far.
+     */
+    uint64_t frames_published() const { return frames_published_; }
+
+private:
+    void publisher_thread();
+    void publish(const uint8_t* bgra_data, int width, int height);
+
+    std::string name_;
+    int preview_width_;
+    int publish_fps_;
+    FrameProvider frame_provider_;
+    GenerationProvider generation_provider_;
+
+    int fd_{-1};
+    Header* header_{nullptr};
+    uint8_t* pixels_{nullptr};
+    size_t mapped_size_{0};
+    size_t payload_capacity_{0};
+
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> frames_published_{0};
+    std::thread thread_;
+};
+
+} // namespace html2ndi
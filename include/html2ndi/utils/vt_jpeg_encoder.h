@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace html2ndi {
+
+/**
+ * JPEG encoder for the streaming preview path.
+ * On macOS frames go through a VideoToolbox hardware compression session,
+ * so repeated preview encodes cost near-zero CPU. If a session cannot be
+ * created (or off macOS) it falls back to the software stb path used by
+ * the /thumbnail endpoint.
+ */
+class VtJpegEncoder {
+public:
+    VtJpegEncoder();
+    ~VtJpegEncoder();
+
+    // Non-copyable, non-movable
+    VtJpegEncoder(const VtJpegEncoder&) = delete;
+    VtJpegEncoder& operator=(const VtJpegEncoder&) = delete;
+
+    /**
+     * Encode one BGRA frame to JPEG.
+     * The compression session is recreated if dimensions or quality change.
+     * @param bgra_data Input BGRA pixel data
+     * @param width Frame width
+     * @param height Frame height
+     * @param quality JPEG quality (1-100)
+     * @param out_jpeg Output JPEG data
+     * @return true if encoding succeeded
+     */
+    bool encode(const uint8_t* bgra_data, int width, int height, int quality,
+                std::vector<uint8_t>& out_jpeg);
+
+    /**
+     * Check whether frames are going through the hardware session.
+     */
+    bool hardware_active() const { return hardware_active_; }
+
+private:
+#ifdef __APPLE__
+    bool ensure_session(int width, int height, int quality);
+    void destroy_session();
+
+    void* session_{nullptr}; // VTCompressionSessionRef, opaque to keep VT out of the header
+    int session_width_{0};
+    int session_height_{0};
+    int session_quality_{0};
+    int64_t frame_number_{0};
+#endif
+    bool hardware_active_{false};
+};
+
+} // namespace html2ndi
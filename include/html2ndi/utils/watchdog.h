@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <functional>
@@ -9,15 +10,23 @@ namespace html2ndi {
 
 /**
  * Watchdog timer to detect main loop hangs.
- * 
+ *
  * The main loop must call heartbeat() periodically.
  * If no heartbeat is received within the timeout period,
  * the watchdog triggers an action (default: abort).
+ *
+ * Beyond the hard timeout, the watchdog doubles as a stall profiler:
+ * heartbeat intervals are tracked in a histogram, and when the gap
+ * since the last heartbeat exceeds a configurable soft threshold the
+ * watchdog thread captures and logs backtraces of the registered
+ * threads while the stall is still in progress. This turns sub-timeout
+ * stutters (a 200 ms stall drops 12 frames on air but never trips the
+ * hard timeout) into actionable stacks.
  */
 class Watchdog {
 public:
     using TimeoutCallback = std::function<void()>;
-    
+
     /**
      * Create a watchdog timer.
      * @param timeout Maximum time between heartbeats before triggering
@@ -26,52 +35,112 @@ public:
     explicit Watchdog(
         std::chrono::seconds timeout,
         TimeoutCallback callback = nullptr);
-    
+
     ~Watchdog();
-    
+
     // Non-copyable
     Watchdog(const Watchdog&) = delete;
     Watchdog& operator=(const Watchdog&) = delete;
-    
+
     /**
      * Start the watchdog timer.
      */
     void start();
-    
+
     /**
      * Stop the watchdog timer.
      */
     void stop();
-    
+
     /**
      * Signal that the main loop is still alive.
      * Must be called periodically to prevent timeout.
      */
     void heartbeat();
-    
+
     /**
      * Check if watchdog is running.
      */
     bool is_running() const { return running_; }
-    
+
     /**
      * Get time since last heartbeat.
      */
     std::chrono::milliseconds time_since_heartbeat() const;
 
+    /**
+     * Set the soft stall threshold. Heartbeat gaps longer than this are
+     * logged with backtraces of the registered threads. 0 disables
+     * stall profiling (the hard timeout still applies).
+     */
+    void set_stall_threshold(std::chrono::milliseconds threshold);
+
+    /**
+     * Get the soft stall threshold.
+     */
+    std::chrono::milliseconds stall_threshold() const {
+        return std::chrono::milliseconds(stall_threshold_ms_.load());
+    }
+
+    /**
+     * Get the number of soft stalls detected so far.
+     */
+    uint64_t stall_count() const { return stall_count_; }
+
+    /**
+     * Get the longest heartbeat interval seen, in milliseconds.
+     */
+    int64_t max_interval_ms() const { return max_interval_ms_; }
+
+    /** Number of heartbeat interval histogram buckets. */
+    static constexpr int kIntervalBuckets = 8;
+
+    /**
+     * Get the heartbeat interval histogram.
+     * Bucket i counts intervals below interval_bucket_bounds_ms()[i];
+     * the last bucket is unbounded.
+     */
+    std::array<uint64_t, kIntervalBuckets> interval_histogram() const;
+
+    /**
+     * Get the upper bounds (milliseconds) of the histogram buckets.
+     */
+    static const std::array<int64_t, kIntervalBuckets - 1>& interval_bucket_bounds_ms();
+
+    /**
+     * Register the calling thread for stall backtrace capture.
+     * Threads on the frame path (main loop, pump) call this once at
+     * startup; the registry is process-wide and shared by all Watchdog
+     * instances.
+     * @param name Thread name used in the logged stacks
+     */
+    static void register_current_thread(const char* name);
+
+    /**
+     * Remove the calling thread from the capture registry. Threads that
+     * can exit before the process does must call this on the way out so
+     * the profiler never signals a stale thread id.
+     */
+    static void unregister_current_thread();
+
 private:
     void watchdog_thread();
-    
+    void capture_stall_backtraces(int64_t stalled_ms);
+
     std::chrono::seconds timeout_;
     TimeoutCallback callback_;
-    
+
     std::atomic<bool> running_{false};
     std::atomic<uint64_t> last_heartbeat_{0};
     std::thread thread_;
+
+    // Stall profiler state
+    std::atomic<int64_t> stall_threshold_ms_{0};
+    std::atomic<uint64_t> stall_count_{0};
+    std::atomic<int64_t> max_interval_ms_{0};
+    std::atomic<uint64_t> interval_buckets_[kIntervalBuckets]{};
+    std::atomic<bool> heartbeat_seen_{false};
+    uint64_t stall_reported_epoch_{0}; // Watchdog thread only
 };
 
 } // namespace html2ndi
-
-
-
-
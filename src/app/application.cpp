@@ -6,15 +6,26 @@
 #include "html2ndi/application.h"
 #include "html2ndi/cef/offscreen_renderer.h"
 #include "html2ndi/ndi/ndi_sender.h"
+#include "html2ndi/ndi/audio_pump.h"
 #include "html2ndi/ndi/frame_pump.h"
 #include "html2ndi/ndi/genlock.h"
+#include "html2ndi/ndi/pattern_generator.h"
+#include "html2ndi/ndi/proxy_stream.h"
+#include "html2ndi/http/event_stream.h"
 #include "html2ndi/http/http_server.h"
 #include "html2ndi/utils/logger.h"
 #include "html2ndi/utils/image_encode.h"
+#include "html2ndi/utils/metrics.h"
+#include "html2ndi/utils/shm_preview.h"
+#include "html2ndi/utils/watchdog.h"
 
 #include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <thread>
 
+#include <unistd.h>
+
 namespace html2ndi {
 
 Application::Application(Config config)
@@ -34,7 +45,31 @@ Application::~Application() {
 
 bool Application::initialize() {
     LOG_DEBUG("Initializing application...");
-    
+
+    // Seed the RCU config store with the startup configuration
+    config_store_ = std::make_unique<ConfigStore>(config_);
+
+    // SSE hub for GET /events; created before the HTTP server so handlers
+    // can subscribe from the first request
+    events_ = std::make_unique<EventStream>();
+
+    // Pattern mode bypasses CEF entirely, so the deferred-NDI dance and
+    // extra browsers have nothing to attach to
+    if (config_.test_pattern) {
+        if (config_.prewarm) {
+            LOG_WARNING("--prewarm is ignored in --pattern mode");
+            config_.prewarm = false;
+        }
+        if (!config_.streams.empty()) {
+            LOG_WARNING("--stream is ignored in --pattern mode");
+            config_.streams.clear();
+        }
+        if (config_.audio) {
+            LOG_WARNING("--audio is ignored in --pattern mode (no page audio)");
+            config_.audio = false;
+        }
+    }
+
     // Initialize genlock if enabled
     if (config_.genlock_mode != "disabled") {
         GenlockMode mode = GenlockMode::Disabled;
@@ -52,43 +87,217 @@ bool Application::initialize() {
             LOG_ERROR("Failed to initialize genlock");
             return false;
         }
+
+        // An explicit send-slot phase offset pins this stream's position
+        // in the frame interval; otherwise slaves take the master's
+        // automatic stagger assignment
+        if (config_.genlock_phase_us >= 0) {
+            genlock_clock_->set_phase_offset_us(config_.genlock_phase_us);
+        }
     }
     
-    // Initialize NDI sender
-    LOG_DEBUG("Creating NDI sender: %s", config_.ndi_name.c_str());
-    ndi_sender_ = std::make_unique<NdiSender>(config_.ndi_name, config_.ndi_groups);
-    if (!ndi_sender_->initialize()) {
-        LOG_ERROR("Failed to initialize NDI sender");
+    // Initialize NDI sender and frame pump. In warm-spare mode both are
+    // deferred: CEF spins up on about:blank now and activate() creates
+    // them when the Manager hands over the real URL and NDI name.
+    if (config_.prewarm) {
+        LOG_INFO("Warm-spare mode: NDI deferred until POST /activate");
+    } else if (!create_sender_and_pump(config_.ndi_name)) {
         return false;
     }
-    
-    // Create frame pump with genlock
-    LOG_DEBUG("Creating frame pump at %d fps (%s)", config_.fps, config_.progressive ? "progressive" : "interlaced");
-    frame_pump_ = std::make_unique<FramePump>(ndi_sender_.get(), config_.fps, config_.progressive, genlock_clock_);
-    
-    // Create CEF renderer with frame callback
-    LOG_DEBUG("Creating CEF renderer %dx%d", config_.width, config_.height);
-    renderer_ = std::make_unique<OffscreenRenderer>(
-        config_,
-        [this](const void* buffer, int width, int height) {
-            // Forward frame to pump
-            if (frame_pump_) {
-                frame_pump_->submit_frame(buffer, width, height);
+
+    if (config_.test_pattern) {
+        // No CEF: a procedural generator is the frame source. Everything
+        // downstream (pump, sender, HTTP API) runs exactly as in page mode,
+        // which is what makes this a clean NDI-path benchmark.
+        LOG_INFO("Pattern mode: generating test pattern, CEF disabled");
+        pattern_generator_ = std::make_unique<PatternGenerator>(
+            config_.width, config_.height, config_.fps_n, config_.fps_d,
+            [this](const void* buffer, int width, int height,
+                   const FrameRectList& dirty_rects) {
+                frame_pump_->submit_frame(buffer, width, height, dirty_rects);
+                if (!first_frame_seen_.exchange(true)) {
+                    record_first_frame();
+                }
+            });
+    } else {
+        // Create CEF renderer with frame callback
+        LOG_DEBUG("Creating CEF renderer %dx%d", config_.width, config_.height);
+        renderer_ = std::make_unique<OffscreenRenderer>(
+            config_,
+            [this](const void* buffer, int width, int height, const FrameRectList& dirty_rects) {
+                // Forward frame to pump (absent until a warm spare goes live)
+                if (activated_.load(std::memory_order_acquire) && frame_pump_) {
+                    frame_pump_->submit_frame(buffer, width, height, dirty_rects);
+                    if (!first_frame_seen_.exchange(true)) {
+                        record_first_frame();
+                    }
+                }
             }
+        );
+
+        // Audio capture: CEF's audio thread pushes packets into the pump's
+        // wait-free ring, the pump drains to the NDI sender at frame cadence
+        if (config_.audio) {
+            LOG_DEBUG("Creating audio pump");
+            audio_pump_ = std::make_unique<AudioPump>(
+                [this](const float* data, int sample_rate, int channels, int samples) {
+                    // No sender yet while a warm spare idles
+                    if (ndi_sender_) {
+                        ndi_sender_->send_audio_frame(data, sample_rate, channels, samples);
+                    }
+                },
+                config_.fps_n, config_.fps_d);
+            renderer_->set_audio_callbacks(
+                [this](int sample_rate, int channels) {
+                    audio_pump_->on_stream_started(sample_rate, channels);
+                },
+                [this](const float** data, int frames) {
+                    audio_pump_->push_packet(data, frames);
+                },
+                [this] { audio_pump_->on_stream_stopped(); });
+        }
+
+        if (!renderer_->initialize()) {
+            LOG_ERROR("Failed to initialize CEF renderer");
+            return false;
         }
-    );
-    
-    if (!renderer_->initialize()) {
-        LOG_ERROR("Failed to initialize CEF renderer");
-        return false;
     }
-    
+
+
     // Start frame pump
-    frame_pump_->start();
-    
-    // Load initial URL
-    renderer_->load_url(config_.url);
-    
+    if (frame_pump_) {
+        frame_pump_->start();
+        activated_ = true;
+    }
+    if (audio_pump_) {
+        audio_pump_->start();
+    }
+    if (pattern_generator_) {
+        pattern_generator_->start();
+    }
+    if (proxy_stream_) {
+        proxy_stream_->start();
+    }
+
+    if (config_.prewarm && !config_.streams.empty()) {
+        LOG_WARNING("--stream is ignored in warm-spare mode");
+        config_.streams.clear();
+    }
+
+    // Additional streams share the CEF instance: each gets its own browser,
+    // pump and sender, but Chromium's process tree exists only once
+    for (const auto& stream_cfg : config_.streams) {
+        LOG_INFO("Creating stream '%s': %s",
+                 stream_cfg.ndi_name.c_str(), stream_cfg.url.c_str());
+
+        auto stream = std::make_unique<Stream>();
+        stream->ndi_name = stream_cfg.ndi_name;
+        stream->sender = std::make_unique<NdiSender>(stream_cfg.ndi_name,
+                                                     config_.ndi_groups);
+        stream->sender->set_async_send(config_.ndi_async_send);
+        stream->sender->set_pixel_format(ndi_sender_->pixel_format());
+        if (!stream->sender->initialize()) {
+            LOG_ERROR("Failed to initialize NDI sender for stream '%s'",
+                      stream_cfg.ndi_name.c_str());
+            return false;
+        }
+
+        stream->pump = std::make_unique<FramePump>(stream->sender.get(),
+                                                   config_.fps,
+                                                   config_.progressive,
+                                                   genlock_clock_);
+        stream->pump->set_target_fps(config_.fps_n, config_.fps_d);
+        stream->pump->set_idle_fps(static_cast<int>(config_.idle_fps));
+        stream->pump->preallocate(config_.width, config_.height);
+
+        FramePump* pump = stream->pump.get();
+        stream->renderer_stream_id = renderer_->create_stream(
+            stream_cfg.url, config_.width, config_.height,
+            [pump](const void* buffer, int width, int height,
+                   const FrameRectList& dirty_rects) {
+                pump->submit_frame(buffer, width, height, dirty_rects);
+            });
+        if (stream->renderer_stream_id < 0) {
+            LOG_ERROR("Failed to create browser for stream '%s'",
+                      stream_cfg.ndi_name.c_str());
+            return false;
+        }
+
+        stream->pump->start();
+        streams_.push_back(std::move(stream));
+    }
+
+    // Main-loop watchdog with soft-stall profiling: gaps over the
+    // threshold are logged with backtraces while the stall is live
+    watchdog_ = std::make_unique<Watchdog>(std::chrono::seconds(kWatchdogTimeout));
+    watchdog_->set_stall_threshold(
+        std::chrono::milliseconds(config_.stall_threshold_ms));
+
+    // Hot reload: watch the config file and push changed values into
+    // the subsystems when a new snapshot is published
+    if (!config_.config_file.empty()) {
+        config_store_->set_change_callback(
+            [this](const Config& previous, const Config& current) {
+                if (current.url != previous.url) {
+                    set_url(current.url);
+                }
+                if (current.idle_fps != previous.idle_fps && frame_pump_) {
+                    frame_pump_->set_idle_fps(static_cast<int>(current.idle_fps));
+                    for (auto& stream : streams_) {
+                        stream->pump->set_idle_fps(static_cast<int>(current.idle_fps));
+                    }
+                }
+                if (current.log_level != previous.log_level) {
+                    Logger::instance().set_level(
+                        static_cast<LogLevel>(current.log_level));
+                }
+                if (current.stall_threshold_ms != previous.stall_threshold_ms &&
+                    watchdog_) {
+                    watchdog_->set_stall_threshold(
+                        std::chrono::milliseconds(current.stall_threshold_ms));
+                }
+            });
+        config_store_->watch_file(config_.config_file);
+    }
+
+    // Publish subsystem counters into the metrics registry. The samplers
+    // read the atomics the subsystems already maintain, so nothing new
+    // happens on the frame path. Deferred for a warm spare: the sender
+    // and pump the samplers read do not exist yet.
+    if (!config_.prewarm) {
+        register_metrics();
+    }
+
+    // Load initial URL. A warm spare parks on about:blank so Chromium is
+    // fully warmed up (GPU process, JIT, font caches) before going live.
+    if (renderer_) {
+        renderer_->load_url(config_.prewarm ? "about:blank" : config_.url);
+    }
+
+    // Shared-memory preview for a local supervisor (zero-copy alternative
+    // to polling /thumbnail)
+    if (config_.shm_preview) {
+        const std::string segment_name = "/html2ndi." + std::to_string(getpid());
+        shm_preview_ = std::make_unique<ShmPreview>(
+            segment_name,
+            static_cast<int>(config_.shm_preview_width),
+            static_cast<int>(config_.shm_preview_fps),
+            [this](std::vector<uint8_t>& data, int& width, int& height) {
+                return frame_pump_ &&
+                       frame_pump_->get_current_frame(data, width, height);
+            },
+            [this] {
+                return frame_pump_ ? frame_pump_->content_generation() : 0;
+            });
+        if (shm_preview_->initialize()) {
+            shm_preview_->start();
+        } else {
+            LOG_WARNING("Failed to initialize shm preview (continuing without it)");
+            shm_preview_.reset();
+        }
+    }
+
+
     // Start HTTP server if enabled
     if (config_.http_enabled) {
         LOG_DEBUG("Starting HTTP server on %s:%d", 
@@ -105,35 +314,415 @@ bool Application::initialize() {
     return true;
 }
 
+bool Application::create_sender_and_pump(const std::string& ndi_name) {
+    LOG_DEBUG("Creating NDI sender: %s", ndi_name.c_str());
+    ndi_sender_ = std::make_unique<NdiSender>(ndi_name, config_.ndi_groups);
+    ndi_sender_->set_async_send(config_.ndi_async_send);
+    if (config_.alpha) {
+        // Alpha mode overrides --pixel-format: alpha only travels in BGRA
+        ndi_sender_->set_pixel_format(PixelFormat::BGRA);
+    } else {
+        ndi_sender_->set_pixel_format(config_.ndi_pixel_format == "uyvy"
+                                          ? PixelFormat::UYVY
+                                          : PixelFormat::BGRX);
+    }
+    if (!ndi_sender_->initialize()) {
+        LOG_ERROR("Failed to initialize NDI sender");
+        return false;
+    }
+
+    // Create frame pump with genlock
+    LOG_DEBUG("Creating frame pump at %d/%d fps (%s)", config_.fps_n, config_.fps_d,
+              config_.progressive ? "progressive" : "interlaced");
+    frame_pump_ = std::make_unique<FramePump>(ndi_sender_.get(), config_.fps, config_.progressive, genlock_clock_);
+    frame_pump_->set_target_fps(config_.fps_n, config_.fps_d);
+    frame_pump_->set_idle_fps(static_cast<int>(config_.idle_fps));
+    frame_pump_->preallocate(config_.width, config_.height);
+
+    // Optional low-bandwidth proxy output tapped off this pump
+    if (config_.proxy && !proxy_stream_) {
+        if (!create_proxy_stream(ndi_name, static_cast<int>(config_.proxy_width),
+                                 static_cast<int>(config_.proxy_fps))) {
+            LOG_WARNING("Continuing without proxy stream");
+        }
+    }
+
+    return true;
+}
+
+bool Application::create_proxy_stream(const std::string& base_name, int width,
+                                      int fps) {
+    proxy_stream_ = std::make_unique<ProxyStream>(
+        base_name + ".proxy", config_.ndi_groups, width, fps,
+        [this](std::vector<uint8_t>& data, int& w, int& h) {
+            return frame_pump_ && frame_pump_->get_current_frame(data, w, h);
+        },
+        [this] {
+            return frame_pump_ ? frame_pump_->content_generation() : 0;
+        });
+    if (!proxy_stream_->initialize()) {
+        proxy_stream_.reset();
+        return false;
+    }
+    return true;
+}
+
+bool Application::enable_proxy(int width, int fps) {
+    std::lock_guard<std::mutex> lock(proxy_mutex_);
+    if (proxy_stream_) {
+        return true;
+    }
+    if (!ndi_sender_ || !frame_pump_) {
+        LOG_WARNING("Proxy requested but no primary sender yet (prewarmed)");
+        return false;
+    }
+    if (!create_proxy_stream(ndi_sender_->name(), width, fps)) {
+        return false;
+    }
+    proxy_stream_->start();
+    config_.proxy = true;
+    config_.proxy_width = static_cast<uint32_t>(width);
+    config_.proxy_fps = static_cast<uint32_t>(fps);
+    return true;
+}
+
+void Application::disable_proxy() {
+    std::lock_guard<std::mutex> lock(proxy_mutex_);
+    if (proxy_stream_) {
+        proxy_stream_->stop();
+        proxy_stream_.reset();
+        config_.proxy = false;
+    }
+}
+
+void Application::record_first_frame() {
+    const auto now = std::chrono::steady_clock::now();
+    const double since_start =
+        std::chrono::duration<double, std::milli>(now - start_time_).count();
+    time_to_first_frame_ms_ = since_start;
+    LOG_INFO("First frame submitted %.0f ms after process start", since_start);
+
+    if (config_.prewarm) {
+        const double since_activate =
+            std::chrono::duration<double, std::milli>(now - activation_time_).count();
+        activation_to_first_frame_ms_ = since_activate;
+        LOG_INFO("Warm spare live: first frame %.0f ms after activation",
+                 since_activate);
+    }
+}
+
+bool Application::activate(const std::string& url, const std::string& ndi_name) {
+    std::lock_guard<std::mutex> lock(activate_mutex_);
+
+    if (activated_) {
+        LOG_WARNING("activate() called but worker is already live");
+        return false;
+    }
+
+    LOG_INFO("Activating warm spare: url=%s ndi_name=%s",
+             url.c_str(), ndi_name.empty() ? config_.ndi_name.c_str()
+                                           : ndi_name.c_str());
+    activation_time_ = std::chrono::steady_clock::now();
+
+    if (!create_sender_and_pump(ndi_name.empty() ? config_.ndi_name : ndi_name)) {
+        ndi_sender_.reset();
+        frame_pump_.reset();
+        return false;
+    }
+    frame_pump_->start();
+    if (proxy_stream_) {
+        proxy_stream_->start();
+    }
+    register_metrics();
+
+    // Publish the pump to the frame callback only once it is running
+    activated_.store(true, std::memory_order_release);
+
+    set_url(url);
+    return true;
+}
+
+void Application::register_metrics() {
+    auto& registry = MetricsRegistry::instance();
+    using Type = MetricsRegistry::Type;
+
+    // Frame pump counters (samplers read the pump's own atomics)
+    registry.register_metric("html2ndi_frames_sent_total",
+                             "Frames delivered to NDI", Type::Counter,
+                             [this] { return static_cast<double>(frame_pump_->frames_sent()); });
+    registry.register_metric("html2ndi_frames_dropped_total",
+                             "Frames dropped because none was available", Type::Counter,
+                             [this] { return static_cast<double>(frame_pump_->frames_dropped()); });
+    registry.register_metric("html2ndi_frames_held_total",
+                             "Frames repeated while content was unchanged", Type::Counter,
+                             [this] { return static_cast<double>(frame_pump_->frames_held()); });
+    registry.register_metric("html2ndi_frames_duplicate_total",
+                             "Submits discarded as pixel-identical repaints", Type::Counter,
+                             [this] { return static_cast<double>(frame_pump_->duplicate_frames()); });
+    registry.register_metric("html2ndi_frames_idle_skipped_total",
+                             "Pump ticks suppressed by the idle keepalive policy", Type::Counter,
+                             [this] { return static_cast<double>(frame_pump_->frames_idle_skipped()); });
+    registry.register_metric("html2ndi_frame_full_copies_total",
+                             "Full-frame copies in submit_frame", Type::Counter,
+                             [this] { return static_cast<double>(frame_pump_->full_copy_count()); });
+    registry.register_metric("html2ndi_frame_partial_copies_total",
+                             "Dirty-rect copies in submit_frame", Type::Counter,
+                             [this] { return static_cast<double>(frame_pump_->partial_copy_count()); });
+    registry.register_metric("html2ndi_frame_submit_time_us",
+                             "Average frame submit time in microseconds", Type::Gauge,
+                             [this] { return frame_pump_->avg_submit_time_us(); });
+    registry.register_metric("html2ndi_frame_buffer_bytes",
+                             "Current frame buffer size in bytes", Type::Gauge,
+                             [this] { return static_cast<double>(frame_pump_->current_buffer_size()); });
+    registry.register_metric("html2ndi_frame_pool_bytes",
+                             "Total bytes held by the frame buffer pool", Type::Gauge,
+                             [this] { return static_cast<double>(frame_pump_->pool_bytes()); });
+    registry.register_metric("html2ndi_bandwidth_bytes_per_second",
+                             "Estimated NDI output bandwidth", Type::Gauge,
+                             [this] { return static_cast<double>(frame_pump_->bandwidth_bytes_per_sec()); });
+    registry.register_metric("html2ndi_actual_fps",
+                             "Measured output frames per second", Type::Gauge,
+                             [this] { return static_cast<double>(frame_pump_->actual_fps()); });
+    registry.register_metric("html2ndi_frame_jitter_us",
+                             "Average pump scheduling jitter in microseconds", Type::Gauge,
+                             [this] { return frame_pump_->avg_jitter_us(); });
+    registry.register_metric("html2ndi_frame_jitter_max_us",
+                             "Worst pump scheduling jitter in microseconds", Type::Gauge,
+                             [this] { return static_cast<double>(frame_pump_->max_jitter_us()); });
+    registry.register_metric("html2ndi_pipeline_latency_us",
+                             "Paint-to-send latency of the last new frame", Type::Gauge,
+                             [this] { return static_cast<double>(frame_pump_->last_pipeline_latency_us()); });
+
+    // NDI sender
+    registry.register_metric("html2ndi_ndi_connections",
+                             "Connected NDI receivers", Type::Gauge,
+                             [this] { return static_cast<double>(ndi_sender_->get_connection_count()); });
+
+    // Audio capture (only when enabled)
+    if (audio_pump_) {
+        registry.register_metric("html2ndi_audio_packets_total",
+                                 "Audio packets captured from CEF", Type::Counter,
+                                 [this] { return static_cast<double>(audio_pump_->packets_received()); });
+        registry.register_metric("html2ndi_audio_samples_dropped_total",
+                                 "Audio samples dropped because the capture ring was full", Type::Counter,
+                                 [this] { return static_cast<double>(audio_pump_->frames_dropped()); });
+        registry.register_metric("html2ndi_audio_av_offset_ms",
+                                 "Smoothed audio capture-to-send latency", Type::Gauge,
+                                 [this] { return audio_pump_->av_offset_ms(); });
+    }
+
+    // Per-stream counters (multi-stream mode)
+    for (size_t i = 0; i < streams_.size(); i++) {
+        Stream* stream = streams_[i].get();
+        const std::string prefix = "html2ndi_stream" + std::to_string(i + 1) + "_";
+        registry.register_metric(prefix + "frames_sent_total",
+                                 "Frames delivered to NDI (" + stream->ndi_name + ")",
+                                 Type::Counter,
+                                 [stream] { return static_cast<double>(stream->pump->frames_sent()); });
+        registry.register_metric(prefix + "actual_fps",
+                                 "Measured output fps (" + stream->ndi_name + ")",
+                                 Type::Gauge,
+                                 [stream] { return static_cast<double>(stream->pump->actual_fps()); });
+        registry.register_metric(prefix + "ndi_connections",
+                                 "Connected NDI receivers (" + stream->ndi_name + ")",
+                                 Type::Gauge,
+                                 [stream] { return static_cast<double>(stream->sender->get_connection_count()); });
+    }
+
+    // Genlock (only when enabled)
+    if (genlock_clock_) {
+        registry.register_metric("html2ndi_genlock_synchronized",
+                                 "1 when genlock is synchronized", Type::Gauge,
+                                 [this] { return genlock_clock_->is_synchronized() ? 1.0 : 0.0; });
+        registry.register_metric("html2ndi_genlock_offset_us",
+                                 "Current genlock offset in microseconds", Type::Gauge,
+                                 [this] { return static_cast<double>(genlock_clock_->sync_offset_us()); });
+        registry.register_metric("html2ndi_genlock_packets_sent_total",
+                                 "Genlock sync packets sent (master)", Type::Counter,
+                                 [this] { return static_cast<double>(genlock_clock_->get_stats().sync_packets_sent); });
+        registry.register_metric("html2ndi_genlock_packets_received_total",
+                                 "Genlock sync packets received (slave)", Type::Counter,
+                                 [this] { return static_cast<double>(genlock_clock_->get_stats().sync_packets_received); });
+        registry.register_metric("html2ndi_genlock_sync_failures_total",
+                                 "Failed genlock sync attempts (slave)", Type::Counter,
+                                 [this] { return static_cast<double>(genlock_clock_->get_stats().sync_failures); });
+        registry.register_metric("html2ndi_genlock_jitter_us",
+                                 "Genlock timing jitter in microseconds", Type::Gauge,
+                                 [this] { return genlock_clock_->get_stats().jitter_us; });
+    }
+}
+
 int Application::run() {
     LOG_DEBUG("Entering main loop");
-    
+
+    Watchdog::register_current_thread("main");
+    if (watchdog_) {
+        watchdog_->start();
+    }
+
+    // Unwatched-source governor state: when the last receiver disconnects
+    // (or drops off program/preview in tally mode), the render and send
+    // rate fall to throttle_fps after a short grace period. The saved rate
+    // is whatever the pump ran at, so a runtime /framerate change survives
+    // a throttle cycle.
+    const bool throttling_enabled = config_.throttle_mode != "off";
+    auto unwatched_since = std::chrono::steady_clock::time_point{};
+    int saved_fps_n = 0;
+    int saved_fps_d = 1;
+
+    // Push-channel state: last observed values, so GET /events carries
+    // deltas instead of a 20 Hz firehose of identical snapshots
+    int last_connections = -1;
+    bool last_on_program = false;
+    bool last_on_preview = false;
+    uint64_t last_content_generation = 0;
+    auto last_status_push = std::chrono::steady_clock::now();
+    char last_status[256] = {0};
+
     // Run CEF message loop
-    // This blocks until shutdown is requested
+    // This blocks until shutdown is requested. In pattern mode there is
+    // no renderer: the loop just keeps heartbeats and stats ticking.
     while (!shutdown_requested_) {
-        renderer_->do_message_loop_work();
-        
+        if (watchdog_) {
+            watchdog_->heartbeat();
+        }
+        if (renderer_) {
+            renderer_->do_message_loop_work();
+        }
+
         // Update actual FPS from frame pump
         if (frame_pump_) {
             actual_fps_ = frame_pump_->actual_fps();
         }
-        
+
         auto now = std::chrono::steady_clock::now();
         auto uptime = std::chrono::duration_cast<std::chrono::seconds>(now - start_time_).count();
-        
-        // Performance monitoring and recovery (after initial startup period)
-        if (uptime > kWatchdogStartupDelay) {
+
+        // Feed the SSE push channel. All of this is delta-gated and only
+        // polled while someone is actually subscribed.
+        if (events_->client_count() > 0) {
+            char buf[256];
+
+            if (ndi_sender_) {
+                const int conns = ndi_sender_->get_connection_count();
+                if (conns != last_connections) {
+                    snprintf(buf, sizeof(buf), "{\"connections\": %d}", conns);
+                    events_->publish("connections", buf);
+                    last_connections = conns;
+                }
+
+                const auto tally = ndi_sender_->get_tally();
+                if (tally.on_program != last_on_program ||
+                    tally.on_preview != last_on_preview) {
+                    snprintf(buf, sizeof(buf),
+                             "{\"on_program\": %s, \"on_preview\": %s}",
+                             tally.on_program ? "true" : "false",
+                             tally.on_preview ? "true" : "false");
+                    events_->publish("tally", buf);
+                    last_on_program = tally.on_program;
+                    last_on_preview = tally.on_preview;
+                }
+            }
+
+            if (frame_pump_) {
+                const uint64_t gen = frame_pump_->content_generation();
+                if (gen != last_content_generation) {
+                    snprintf(buf, sizeof(buf), "{\"generation\": %llu}",
+                             static_cast<unsigned long long>(gen));
+                    events_->publish("frame", buf);
+                    last_content_generation = gen;
+                }
+            }
+
+            // Compact status snapshot roughly once a second, suppressed
+            // when nothing in it changed
+            if (now - last_status_push >= std::chrono::seconds(1)) {
+                last_status_push = now;
+                snprintf(buf, sizeof(buf),
+                         "{\"fps\": %.1f, \"connections\": %d, "
+                         "\"frames_sent\": %llu, \"frames_dropped\": %llu, "
+                         "\"throttled\": %s}",
+                         actual_fps_.load(),
+                         ndi_sender_ ? ndi_sender_->get_connection_count() : 0,
+                         static_cast<unsigned long long>(
+                             frame_pump_ ? frame_pump_->frames_sent() : 0),
+                         static_cast<unsigned long long>(
+                             frame_pump_ ? frame_pump_->frames_dropped() : 0),
+                         render_throttled_.load() ? "true" : "false");
+                if (strcmp(buf, last_status) != 0) {
+                    events_->publish("status", buf);
+                    snprintf(last_status, sizeof(last_status), "%s", buf);
+                }
+            }
+        }
+
+        // Govern the render rate by who is actually watching. The loop
+        // ticks at least every 50 ms, so the snap back to full rate lands
+        // within one output frame of a receiver connecting.
+        if (throttling_enabled && ndi_sender_ && frame_pump_) {
+            const int connections = ndi_sender_->get_connection_count();
+            bool watched = connections > 0;
+            if (watched && config_.throttle_mode == "tally") {
+                const auto tally = ndi_sender_->get_tally();
+                watched = tally.on_program || tally.on_preview;
+            }
+
+            if (watched) {
+                unwatched_since = {};
+                if (render_throttled_.exchange(false)) {
+                    frame_pump_->set_target_fps(saved_fps_n, saved_fps_d);
+                    if (renderer_) {
+                        renderer_->set_frame_rate(config_.fps);
+                    }
+                    LOG_INFO("Source watched again (%d connections): restoring %d/%d fps",
+                             connections, saved_fps_n, saved_fps_d);
+                    events_->publish("throttle", "{\"throttled\": false}");
+                }
+            } else if (!render_throttled_) {
+                if (unwatched_since == std::chrono::steady_clock::time_point{}) {
+                    unwatched_since = now;
+                } else if (now - unwatched_since >=
+                           std::chrono::seconds(kThrottleGraceSeconds)) {
+                    saved_fps_n = frame_pump_->target_fps_n();
+                    saved_fps_d = frame_pump_->target_fps_d();
+                    frame_pump_->set_target_fps(
+                        static_cast<int>(config_.throttle_fps), 1);
+                    if (renderer_) {
+                        renderer_->set_frame_rate(
+                            static_cast<int>(config_.throttle_fps));
+                    }
+                    render_throttled_ = true;
+                    LOG_INFO("No one watching (%s policy): throttling to %u fps",
+                             config_.throttle_mode.c_str(), config_.throttle_fps);
+                    events_->publish("throttle", "{\"throttled\": true}");
+                }
+            }
+        }
+
+        // Performance monitoring and recovery (after initial startup period).
+        // The recovery levers are all page-side, so skip in pattern mode.
+        if (renderer_ && uptime > kWatchdogStartupDelay) {
             // Check for frame rate degradation
             float target_fps = static_cast<float>(config_.fps);
             float fps_threshold = target_fps * kFpsThresholdRatio;
             
-            if (actual_fps_ < fps_threshold && actual_fps_ > 0.1f) {
+            // A throttled source runs below target on purpose; do not
+            // treat that as degradation and reload the page
+            if (actual_fps_ < fps_threshold && actual_fps_ > 0.1f &&
+                !render_throttled_) {
                 degradation_count_++;
                 
                 if (degradation_count_ >= kDegradationCheckCount) {
-                    LOG_WARNING("Frame rate degradation detected: %.1f fps (target: %.0f fps). Triggering recovery...", 
+                    LOG_WARNING("Frame rate degradation detected: %.1f fps (target: %.0f fps). Triggering recovery...",
                                actual_fps_.load(), target_fps);
-                    
+
+                    char buf[128];
+                    snprintf(buf, sizeof(buf),
+                             "{\"fps\": %.1f, \"target_fps\": %.0f}",
+                             actual_fps_.load(), target_fps);
+                    events_->publish("degradation", buf);
+
+
                     // Try JavaScript GC first
                     renderer_->execute_javascript("if (window.gc) window.gc();");
                     renderer_->notify_memory_pressure();
@@ -166,8 +755,13 @@ int Application::run() {
             }
         }
         
-        // Small sleep to prevent spinning
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        // Block until CEF schedules work (external pump) instead of
+        // polling; bounded so heartbeats and monitoring keep running
+        if (renderer_) {
+            renderer_->wait_for_work(std::chrono::milliseconds(50));
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
     }
     
     LOG_DEBUG("Exiting main loop");
@@ -180,7 +774,22 @@ void Application::shutdown() {
     }
     
     LOG_INFO("Shutting down application...");
-    
+
+    // Stop the watchdog before teardown makes heartbeats stop
+    if (watchdog_) {
+        watchdog_->stop();
+    }
+
+    // Stop the config watcher before the subsystems its callback touches
+    if (config_store_) {
+        config_store_->stop_watching();
+    }
+
+    // Wake blocked /events providers so the HTTP server can stop cleanly
+    if (events_) {
+        events_->shutdown();
+    }
+
     // Stop HTTP server first
     if (http_server_) {
         LOG_DEBUG("Stopping HTTP server");
@@ -188,23 +797,59 @@ void Application::shutdown() {
         http_server_.reset();
     }
     
-    // Stop frame pump
+    // Stop shm preview publisher before the pump it reads from
+    if (shm_preview_) {
+        LOG_DEBUG("Stopping shm preview");
+        shm_preview_->stop();
+        shm_preview_->shutdown();
+        shm_preview_.reset();
+    }
+
+    // Stop the proxy before the pump it reads from
+    if (proxy_stream_) {
+        LOG_DEBUG("Stopping proxy stream");
+        proxy_stream_->stop();
+    }
+
+    // Stop the pattern generator before the pump it feeds
+    if (pattern_generator_) {
+        LOG_DEBUG("Stopping pattern generator");
+        pattern_generator_->stop();
+    }
+
+    // Stop the audio pump before the sender it drains into
+    if (audio_pump_) {
+        LOG_DEBUG("Stopping audio pump");
+        audio_pump_->stop();
+    }
+
+    // Stop frame pumps (primary, then streams)
     if (frame_pump_) {
         LOG_DEBUG("Stopping frame pump");
         frame_pump_->stop();
     }
-    
+    for (auto& stream : streams_) {
+        if (stream->pump) {
+            stream->pump->stop();
+        }
+    }
+
     // Shutdown CEF
     if (renderer_) {
         LOG_DEBUG("Shutting down CEF");
         renderer_->shutdown();
     }
-    
+
     // Shutdown NDI
     if (ndi_sender_) {
         LOG_DEBUG("Shutting down NDI sender");
         ndi_sender_->shutdown();
     }
+    for (auto& stream : streams_) {
+        if (stream->sender) {
+            stream->sender->shutdown();
+        }
+    }
     
     LOG_INFO("Shutdown complete");
 }
@@ -213,6 +858,25 @@ bool Application::is_shutting_down() const {
     return shutdown_requested_;
 }
 
+const LatencyHistogram* Application::paint_histogram() const {
+    return renderer_ ? renderer_->paint_histogram() : nullptr;
+}
+
+void Application::reset_latency_histograms() {
+    if (frame_pump_) {
+        frame_pump_->reset_latency_histograms();
+    }
+    for (auto& stream : streams_) {
+        if (stream->pump) {
+            stream->pump->reset_latency_histograms();
+        }
+    }
+    if (renderer_) {
+        renderer_->reset_paint_histogram();
+    }
+    LOG_INFO("Latency histograms reset");
+}
+
 void Application::set_url(const std::string& url) {
     if (renderer_) {
         LOG_INFO("Loading URL: %s", url.c_str());
@@ -232,6 +896,30 @@ void Application::reload() {
     }
 }
 
+bool Application::resize(int width, int height) {
+    if (!renderer_) {
+        LOG_WARNING("Resize requested but no browser (pattern mode)");
+        return false;
+    }
+    if (width == config_.width && height == config_.height) {
+        return true;
+    }
+
+    LOG_INFO("Resizing output %dx%d -> %dx%d",
+             config_.width, config_.height, width, height);
+
+    // Stage the pump first so pinned new-size storage exists before the
+    // browser can deliver a new-size paint
+    if (frame_pump_) {
+        frame_pump_->prepare_resize(width, height);
+    }
+    renderer_->resize(width, height);
+
+    config_.width = width;
+    config_.height = height;
+    return true;
+}
+
 std::string Application::current_url() const {
     if (renderer_) {
         return renderer_->current_url();
@@ -250,25 +938,90 @@ float Application::current_fps() const {
     return actual_fps_;
 }
 
-bool Application::get_thumbnail(std::vector<uint8_t>& out_jpeg, int width, int quality) {
+const std::string& Application::stream_name(size_t index) const {
+    static const std::string empty;
+    return index < streams_.size() ? streams_[index]->ndi_name : empty;
+}
+
+FramePump* Application::stream_pump(size_t index) {
+    return index < streams_.size() ? streams_[index]->pump.get() : nullptr;
+}
+
+NdiSender* Application::stream_sender(size_t index) {
+    return index < streams_.size() ? streams_[index]->sender.get() : nullptr;
+}
+
+std::string Application::stream_url(size_t index) const {
+    if (index >= streams_.size() || !renderer_) {
+        return "";
+    }
+    return renderer_->current_url(streams_[index]->renderer_stream_id);
+}
+
+void Application::stream_set_url(size_t index, const std::string& url) {
+    if (index >= streams_.size() || !renderer_) {
+        return;
+    }
+    LOG_INFO("Loading URL on stream '%s': %s",
+             streams_[index]->ndi_name.c_str(), url.c_str());
+    renderer_->load_url(streams_[index]->renderer_stream_id, url);
+}
+
+void Application::stream_reload(size_t index) {
+    if (index >= streams_.size() || !renderer_) {
+        return;
+    }
+    LOG_INFO("Reloading stream '%s'", streams_[index]->ndi_name.c_str());
+    renderer_->reload(streams_[index]->renderer_stream_id);
+}
+
+std::shared_ptr<const std::vector<uint8_t>> Application::get_thumbnail(int width, int quality) {
     if (!frame_pump_) {
-        return false;
+        return nullptr;
     }
-    
+
+    // Content generation only advances when pixels actually change, so
+    // identical repaints and held frames keep hitting the cache
+    const uint64_t generation = frame_pump_->content_generation();
+
+    {
+        std::lock_guard<std::mutex> lock(thumbnail_mutex_);
+        if (thumbnail_cache_ && thumbnail_generation_ == generation &&
+            thumbnail_width_ == width && thumbnail_quality_ == quality) {
+            // Content has not changed since the last encode at these settings
+            return thumbnail_cache_;
+        }
+    }
+
     std::vector<uint8_t> frame_data;
     int frame_width, frame_height;
-    
+
     if (!frame_pump_->get_current_frame(frame_data, frame_width, frame_height)) {
-        return false;
+        return nullptr;
     }
-    
+
+    auto jpeg = std::make_shared<std::vector<uint8_t>>();
+    bool ok;
     if (width > 0 && width < frame_width) {
-        return encode_jpeg_scaled(frame_data.data(), frame_width, frame_height, 
-                                  width, quality, out_jpeg);
+        ok = encode_jpeg_scaled(frame_data.data(), frame_width, frame_height,
+                                width, quality, *jpeg);
     } else {
-        return encode_jpeg(frame_data.data(), frame_width, frame_height, 
-                          quality, out_jpeg);
+        ok = encode_jpeg(frame_data.data(), frame_width, frame_height,
+                         quality, *jpeg);
+    }
+    if (!ok) {
+        return nullptr;
     }
+
+    {
+        std::lock_guard<std::mutex> lock(thumbnail_mutex_);
+        thumbnail_cache_ = jpeg;
+        thumbnail_generation_ = generation;
+        thumbnail_width_ = width;
+        thumbnail_quality_ = quality;
+    }
+
+    return jpeg;
 }
 
 } // namespace html2ndi
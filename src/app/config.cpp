@@ -5,8 +5,10 @@
 #include "html2ndi/config.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <iostream>
+#include <numeric>
 #include <regex>
 
 namespace html2ndi {
@@ -43,8 +45,9 @@ void Config::print_help(const char* program_name) {
     print_arg("-u", "--url", "<url>", "URL to load (default: about:blank)");
     print_arg("-w", "--width", "<pixels>", "Frame width (default: 1920)");
     print_arg("-h", "--height", "<pixels>", "Frame height (default: 1080)");
-    print_arg("-f", "--fps", "<rate>", "Target framerate (default: 60)");
+    print_arg("-f", "--fps", "<rate>", "Target framerate, e.g. 60, 59.94 or 60000/1001 (default: 60)");
     print_arg("-i", "--interlaced", nullptr, "Use interlaced mode (default: progressive)");
+    print_arg(nullptr, "--idle-fps", "<fps>", "Re-send rate while content is static (default: 0 = full rate)");
     
     std::cout << std::endl;
     std::cout << "NDI Options:" << std::endl;
@@ -52,29 +55,49 @@ void Config::print_help(const char* program_name) {
     print_arg("-g", "--ndi-groups", "<groups>", "NDI groups, comma-separated (default: all)");
     print_arg(nullptr, "--no-clock-video", nullptr, "Disable video clock timing");
     print_arg(nullptr, "--no-clock-audio", nullptr, "Disable audio clock timing");
+    print_arg(nullptr, "--no-async-send", nullptr, "Use synchronous NDI video transmission");
+    print_arg(nullptr, "--pixel-format", "<fmt>", "NDI pixel format: bgra or uyvy (default: bgra)");
+    print_arg(nullptr, "--alpha", nullptr, "Transparent background, output BGRA with alpha");
+    print_arg(nullptr, "--audio", nullptr, "Capture page audio and send it to NDI");
+    print_arg(nullptr, "--proxy", nullptr, "Also send a low-bandwidth \".proxy\" stream for WAN monitoring");
+    print_arg(nullptr, "--proxy-width", "<px>", "Proxy downscale width, 64-1920 (default: 640)");
+    print_arg(nullptr, "--proxy-fps", "<fps>", "Proxy send rate, 1-60 (default: 15)");
+    print_arg(nullptr, "--throttle", "<mode>", "Throttle unwatched sources: off, connections, tally (default: off)");
+    print_arg(nullptr, "--throttle-fps", "<fps>", "Render/send rate while throttled, 1-30 (default: 5)");
+    print_arg(nullptr, "--stream", "<name>,<url>", "Additional NDI stream in the same process (repeatable)");
     
     std::cout << std::endl;
     std::cout << "Genlock Options:" << std::endl;
     print_arg(nullptr, "--genlock", "<mode>", "Genlock mode: disabled, master, slave (default: disabled)");
-    print_arg(nullptr, "--genlock-master", "<addr>", "Master address for slave mode (default: 127.0.0.1:5960)");
+    print_arg(nullptr, "--genlock-master", "<addr>", "Master address, unicast or multicast group (default: 127.0.0.1:5960)");
+    print_arg(nullptr, "--genlock-phase-us", "<us>", "Sub-frame send-slot offset in microseconds (default: automatic stagger)");
     
     std::cout << std::endl;
     std::cout << "HTTP API Options:" << std::endl;
     print_arg(nullptr, "--http-host", "<host>", "HTTP server bind address (default: 127.0.0.1)");
     print_arg("-p", "--http-port", "<port>", "HTTP server port (default: 8080)");
     print_arg(nullptr, "--no-http", nullptr, "Disable HTTP server");
+    print_arg(nullptr, "--status-interval", "<ms>", "GET /status snapshot refresh interval, 0 = per request (default: 250)");
+    print_arg(nullptr, "--shm-preview", nullptr, "Publish frames into a POSIX shm segment for local supervisors");
+    print_arg(nullptr, "--shm-preview-width", "<pixels>", "Shared-memory preview width (default: 640)");
     
     std::cout << std::endl;
     std::cout << "CEF Options:" << std::endl;
     print_arg(nullptr, "--cache-path", "<path>", "Browser cache directory");
     print_arg(nullptr, "--disable-gpu", nullptr, "Disable GPU acceleration");
+    print_arg(nullptr, "--shared-textures", nullptr, "GPU shared-texture rendering (no CPU readback)");
     print_arg(nullptr, "--user-agent", "<ua>", "Custom user agent string");
     
     std::cout << std::endl;
     std::cout << "Application Options:" << std::endl;
+    print_arg("-c", "--config", "<path>", "JSON config file watched for hot reloads");
     print_arg("-l", "--log-file", "<path>", "Log file path");
     print_arg("-v", "--verbose", nullptr, "Enable verbose logging (DEBUG level)");
     print_arg("-q", "--quiet", nullptr, "Quiet mode (ERROR level only)");
+    print_arg(nullptr, "--log-async", nullptr, "Buffer log output through a background drain thread");
+    print_arg(nullptr, "--stall-threshold", "<ms>", "Main-loop stall that triggers backtrace capture, 0 = off (default: 200)");
+    print_arg(nullptr, "--prewarm", nullptr, "Start as warm spare: init CEF on about:blank, go live via POST /activate");
+    print_arg(nullptr, "--pattern", nullptr, "Send a procedural test pattern instead of rendering a page (bypasses CEF)");
     print_arg("-d", "--daemon", nullptr, "Run as daemon (detach from terminal)");
     print_arg(nullptr, "--version", nullptr, "Print version and exit");
     print_arg(nullptr, "--help", nullptr, "Show this help message");
@@ -142,9 +165,18 @@ std::optional<Config> Config::parse(int argc, char* argv[]) {
             config.height = static_cast<uint32_t>(val);
         }
         else if (arg == "-f" || arg == "--fps") {
+            std::string val = get_value();
+            if (!parse_framerate(val, config.fps_n, config.fps_d)) {
+                std::cerr << "Error: Invalid framerate: " << val << std::endl;
+                return std::nullopt;
+            }
+            config.fps = static_cast<uint32_t>(
+                (config.fps_n + config.fps_d / 2) / config.fps_d);
+        }
+        else if (arg == "--idle-fps") {
             int val = get_int();
-            if (val <= 0) return std::nullopt;
-            config.fps = static_cast<uint32_t>(val);
+            if (val < 0) return std::nullopt;
+            config.idle_fps = static_cast<uint32_t>(val);
         }
         else if (arg == "-i" || arg == "--interlaced") {
             config.progressive = false;
@@ -164,6 +196,62 @@ std::optional<Config> Config::parse(int argc, char* argv[]) {
         else if (arg == "--no-clock-audio") {
             config.ndi_clock_audio = false;
         }
+        else if (arg == "--no-async-send") {
+            config.ndi_async_send = false;
+        }
+        else if (arg == "--pixel-format") {
+            config.ndi_pixel_format = get_value();
+            if (config.ndi_pixel_format.empty()) return std::nullopt;
+            std::transform(config.ndi_pixel_format.begin(), config.ndi_pixel_format.end(),
+                          config.ndi_pixel_format.begin(), ::tolower);
+        }
+        else if (arg == "--alpha") {
+            config.alpha = true;
+        }
+        else if (arg == "--audio") {
+            config.audio = true;
+        }
+        else if (arg == "--proxy") {
+            config.proxy = true;
+        }
+        else if (arg == "--throttle") {
+            config.throttle_mode = get_value();
+            std::transform(config.throttle_mode.begin(), config.throttle_mode.end(),
+                           config.throttle_mode.begin(), ::tolower);
+        }
+        else if (arg == "--throttle-fps") {
+            int val = get_int();
+            if (val < 1 || val > 30) {
+                std::cerr << "Error: --throttle-fps must be 1-30" << std::endl;
+                return std::nullopt;
+            }
+            config.throttle_fps = static_cast<uint32_t>(val);
+        }
+        else if (arg == "--proxy-width") {
+            int val = get_int();
+            if (val < 64 || val > 1920) {
+                std::cerr << "Error: --proxy-width must be 64-1920" << std::endl;
+                return std::nullopt;
+            }
+            config.proxy_width = static_cast<uint32_t>(val);
+        }
+        else if (arg == "--proxy-fps") {
+            int val = get_int();
+            if (val < 1 || val > 60) {
+                std::cerr << "Error: --proxy-fps must be 1-60" << std::endl;
+                return std::nullopt;
+            }
+            config.proxy_fps = static_cast<uint32_t>(val);
+        }
+        else if (arg == "--stream") {
+            std::string val = get_value();
+            size_t comma = val.find(',');
+            if (comma == std::string::npos || comma == 0 || comma + 1 >= val.size()) {
+                std::cerr << "Error: --stream expects <name>,<url>" << std::endl;
+                return std::nullopt;
+            }
+            config.streams.push_back({val.substr(0, comma), val.substr(comma + 1)});
+        }
         
         // Genlock options
         else if (arg == "--genlock") {
@@ -176,6 +264,14 @@ std::optional<Config> Config::parse(int argc, char* argv[]) {
             config.genlock_master_addr = get_value();
             if (config.genlock_master_addr.empty()) return std::nullopt;
         }
+        else if (arg == "--genlock-phase-us") {
+            int val = get_int();
+            if (val < 0 || val > 100000) {
+                std::cerr << "Error: --genlock-phase-us must be 0-100000" << std::endl;
+                return std::nullopt;
+            }
+            config.genlock_phase_us = val;
+        }
         
         // HTTP options
         else if (arg == "--http-host") {
@@ -190,7 +286,26 @@ std::optional<Config> Config::parse(int argc, char* argv[]) {
         else if (arg == "--no-http") {
             config.http_enabled = false;
         }
-        
+        else if (arg == "--status-interval") {
+            int val = get_int();
+            if (val < 0 || val > 10000) {
+                std::cerr << "Error: --status-interval must be 0-10000 ms" << std::endl;
+                return std::nullopt;
+            }
+            config.status_interval_ms = static_cast<uint32_t>(val);
+        }
+        else if (arg == "--shm-preview") {
+            config.shm_preview = true;
+        }
+        else if (arg == "--shm-preview-width") {
+            int val = get_int();
+            if (val < 64 || val > 1920) {
+                std::cerr << "Error: --shm-preview-width must be 64-1920" << std::endl;
+                return std::nullopt;
+            }
+            config.shm_preview_width = static_cast<uint32_t>(val);
+        }
+
         // CEF options
         else if (arg == "--cache-path") {
             config.cef_cache_path = get_value();
@@ -198,11 +313,18 @@ std::optional<Config> Config::parse(int argc, char* argv[]) {
         else if (arg == "--disable-gpu") {
             config.cef_disable_gpu = true;
         }
+        else if (arg == "--shared-textures") {
+            config.cef_shared_textures = true;
+        }
         else if (arg == "--user-agent") {
             config.cef_user_agent = get_value();
         }
         
         // Application options
+        else if (arg == "-c" || arg == "--config") {
+            config.config_file = get_value();
+            if (config.config_file.empty()) return std::nullopt;
+        }
         else if (arg == "-l" || arg == "--log-file") {
             config.log_file = get_value();
         }
@@ -212,6 +334,23 @@ std::optional<Config> Config::parse(int argc, char* argv[]) {
         else if (arg == "-q" || arg == "--quiet") {
             config.log_level = 3; // ERROR
         }
+        else if (arg == "--log-async") {
+            config.log_async = true;
+        }
+        else if (arg == "--stall-threshold") {
+            int val = get_int();
+            if (val < 0 || val > 10000) {
+                std::cerr << "Error: --stall-threshold must be 0-10000 ms" << std::endl;
+                return std::nullopt;
+            }
+            config.stall_threshold_ms = static_cast<uint32_t>(val);
+        }
+        else if (arg == "--prewarm") {
+            config.prewarm = true;
+        }
+        else if (arg == "--pattern") {
+            config.test_pattern = true;
+        }
         else if (arg == "-d" || arg == "--daemon") {
             config.daemon_mode = true;
         }
@@ -236,6 +375,54 @@ std::optional<Config> Config::parse(int argc, char* argv[]) {
     return config;
 }
 
+bool Config::parse_framerate(const std::string& str, int& num, int& den) {
+    if (str.empty()) {
+        return false;
+    }
+
+    try {
+        size_t consumed = 0;
+        auto slash = str.find('/');
+        if (slash != std::string::npos) {
+            // Explicit rational: "60000/1001"
+            int n = std::stoi(str.substr(0, slash), &consumed);
+            if (consumed != slash) return false;
+            int d = std::stoi(str.substr(slash + 1), &consumed);
+            if (consumed != str.size() - slash - 1) return false;
+            if (n <= 0 || d <= 0) return false;
+            num = n;
+            den = d;
+        } else if (str.find('.') != std::string::npos) {
+            double value = std::stod(str, &consumed);
+            if (consumed != str.size() || value <= 0.0) return false;
+
+            // NTSC rates are 1000/1001 multiples of an integer; snap values
+            // like 59.94, 29.97 and 23.976 to the exact rational
+            long ntsc = std::lround(value * 1001.0 / 1000.0);
+            if (ntsc > 0 && std::abs(value - ntsc * 1000.0 / 1001.0) < 0.005) {
+                num = static_cast<int>(ntsc) * 1000;
+                den = 1001;
+            } else {
+                // Generic decimal with millihertz precision
+                long n = std::lround(value * 1000.0);
+                if (n <= 0) return false;
+                long g = std::gcd(n, 1000L);
+                num = static_cast<int>(n / g);
+                den = static_cast<int>(1000 / g);
+            }
+        } else {
+            int n = std::stoi(str, &consumed);
+            if (consumed != str.size() || n <= 0) return false;
+            num = n;
+            den = 1;
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    return true;
+}
+
 bool Config::validate() const {
     // Validate resolution
     if (width < 16 || width > 7680) {
@@ -252,6 +439,10 @@ bool Config::validate() const {
         std::cerr << "Error: FPS must be between 1 and 240" << std::endl;
         return false;
     }
+    if (fps_n < 1 || fps_d < 1) {
+        std::cerr << "Error: Invalid rational framerate" << std::endl;
+        return false;
+    }
     
     // Validate NDI name
     if (ndi_name.empty()) {
@@ -265,12 +456,45 @@ bool Config::validate() const {
         return false;
     }
     
-    // Basic URL validation
-    if (url.empty()) {
+    // Basic URL validation (irrelevant in pattern mode, which renders no page)
+    if (url.empty() && !test_pattern) {
         std::cerr << "Error: URL cannot be empty" << std::endl;
         return false;
     }
     
+    // Validate pixel format
+    if (ndi_pixel_format != "bgra" && ndi_pixel_format != "uyvy") {
+        std::cerr << "Error: Pixel format must be 'bgra' or 'uyvy'" << std::endl;
+        return false;
+    }
+
+    // Validate additional streams (names must not collide)
+    for (size_t i = 0; i < streams.size(); i++) {
+        if (streams[i].ndi_name.empty() || streams[i].url.empty()) {
+            std::cerr << "Error: --stream requires a non-empty name and URL" << std::endl;
+            return false;
+        }
+        if (streams[i].ndi_name == ndi_name) {
+            std::cerr << "Error: Stream name '" << streams[i].ndi_name
+                      << "' collides with the primary NDI name" << std::endl;
+            return false;
+        }
+        for (size_t j = i + 1; j < streams.size(); j++) {
+            if (streams[i].ndi_name == streams[j].ndi_name) {
+                std::cerr << "Error: Duplicate stream name '"
+                          << streams[i].ndi_name << "'" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    // Validate throttle mode
+    if (throttle_mode != "off" && throttle_mode != "connections" &&
+        throttle_mode != "tally") {
+        std::cerr << "Error: Throttle mode must be 'off', 'connections', or 'tally'" << std::endl;
+        return false;
+    }
+
     // Validate genlock mode
     if (genlock_mode != "disabled" && genlock_mode != "master" && genlock_mode != "slave") {
         std::cerr << "Error: Genlock mode must be 'disabled', 'master', or 'slave'" << std::endl;
@@ -282,6 +506,13 @@ bool Config::validate() const {
         std::cerr << "Error: Genlock master address required for slave mode" << std::endl;
         return false;
     }
+
+    // Validate genlock phase offset (an explicit one must fit well inside
+    // a frame interval; -1 keeps automatic stagger assignment)
+    if (genlock_phase_us < -1 || genlock_phase_us > 100000) {
+        std::cerr << "Error: Genlock phase offset must be between 0 and 100000 us" << std::endl;
+        return false;
+    }
     
     return true;
 }
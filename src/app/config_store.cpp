@@ -0,0 +1,166 @@
+/**
+ * Hot-reloadable configuration snapshot store.
+ */
+
+#include "html2ndi/config_store.h"
+#include "html2ndi/utils/logger.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using json = nlohmann::json;
+
+namespace html2ndi {
+
+namespace {
+// How often the watcher polls the file's mtime
+constexpr auto kWatchPollInterval = std::chrono::milliseconds(500);
+} // namespace
+
+ConfigStore::ConfigStore(Config initial)
+    : snapshot_(std::make_shared<const Config>(std::move(initial))) {
+}
+
+ConfigStore::~ConfigStore() {
+    stop_watching();
+}
+
+std::shared_ptr<const Config> ConfigStore::snapshot() const {
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+}
+
+void ConfigStore::publish(Config next) {
+    std::atomic_store_explicit(&snapshot_,
+                               std::shared_ptr<const Config>(
+                                   std::make_shared<const Config>(std::move(next))),
+                               std::memory_order_release);
+    generation_++;
+}
+
+void ConfigStore::set_change_callback(ChangeCallback callback) {
+    change_callback_ = std::move(callback);
+}
+
+bool ConfigStore::watch_file(const std::string& path) {
+    if (watching_) {
+        return false;
+    }
+
+    watch_path_ = path;
+    watching_ = true;
+    watch_thread_ = std::thread(&ConfigStore::watcher_thread, this);
+
+    LOG_INFO("Watching config file: %s", path.c_str());
+    return true;
+}
+
+void ConfigStore::stop_watching() {
+    if (!watching_) {
+        return;
+    }
+
+    watching_ = false;
+    if (watch_thread_.joinable()) {
+        watch_thread_.join();
+    }
+
+    LOG_DEBUG("Config file watcher stopped");
+}
+
+bool ConfigStore::apply_json_overrides(const std::string& json_text,
+                                       Config& config, std::string& error) {
+    json doc;
+    try {
+        doc = json::parse(json_text);
+    } catch (const json::exception& e) {
+        error = e.what();
+        return false;
+    }
+
+    if (!doc.is_object()) {
+        error = "config document must be a JSON object";
+        return false;
+    }
+
+    for (const auto& [key, value] : doc.items()) {
+        try {
+            if (key == "url") {
+                config.url = value.get<std::string>();
+            } else if (key == "idle_fps") {
+                config.idle_fps = value.get<uint32_t>();
+            } else if (key == "log_level") {
+                config.log_level = value.get<int>();
+            } else if (key == "stall_threshold_ms") {
+                config.stall_threshold_ms = value.get<uint32_t>();
+            } else if (key == "status_interval_ms") {
+                config.status_interval_ms = value.get<uint32_t>();
+            } else {
+                // Geometry, NDI identity etc. still require a restart
+                LOG_WARNING("Config file key '%s' is not hot-reloadable, ignored",
+                            key.c_str());
+            }
+        } catch (const json::exception& e) {
+            error = std::string("key '") + key + "': " + e.what();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ConfigStore::watcher_thread() {
+    namespace fs = std::filesystem;
+
+    // Poll the mtime rather than using FSEvents so the watcher has no
+    // run-loop dependency; 500 ms latency is fine for operator edits
+    std::error_code ec;
+    fs::file_time_type last_mtime = fs::last_write_time(watch_path_, ec);
+
+    while (watching_) {
+        std::this_thread::sleep_for(kWatchPollInterval);
+        if (!watching_) {
+            break;
+        }
+
+        auto mtime = fs::last_write_time(watch_path_, ec);
+        if (ec || mtime == last_mtime) {
+            continue;
+        }
+        last_mtime = mtime;
+
+        std::ifstream file(watch_path_);
+        if (!file.is_open()) {
+            LOG_WARNING("Config file changed but could not be opened: %s",
+                        watch_path_.c_str());
+            continue;
+        }
+        std::stringstream contents;
+        contents << file.rdbuf();
+
+        Config previous = *snapshot();
+        Config next = previous;
+        std::string error;
+        if (!apply_json_overrides(contents.str(), next, error)) {
+            // Keep serving the last good snapshot on a bad edit
+            LOG_ERROR("Config reload rejected (%s): %s",
+                      watch_path_.c_str(), error.c_str());
+            continue;
+        }
+
+        publish(next);
+        reload_count_++;
+        LOG_INFO("Config reloaded from %s (generation %llu)",
+                 watch_path_.c_str(),
+                 static_cast<unsigned long long>(generation_.load()));
+
+        if (change_callback_) {
+            change_callback_(previous, next);
+        }
+    }
+}
+
+} // namespace html2ndi
@@ -40,7 +40,10 @@ int main(int argc, char* argv[]) {
         }
     }
     Logger::instance().initialize(log_level, log_file);
-    
+    if (config->log_async) {
+        Logger::instance().set_async(true);
+    }
+
     LOG_INFO("HTML2NDI starting...");
     if (!log_file.empty()) {
         LOG_INFO("Log file: %s", log_file.c_str());
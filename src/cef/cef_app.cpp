@@ -64,6 +64,14 @@ CefRefPtr<CefClient> CefAppImpl::GetDefaultClient() {
     return nullptr;
 }
 
+void CefAppImpl::OnScheduleMessagePumpWork(int64_t delay_ms) {
+    // CEF calls this from any thread; the callback wakes the main loop
+    // so CefDoMessageLoopWork runs when work is actually due
+    if (schedule_callback_) {
+        schedule_callback_(delay_ms);
+    }
+}
+
 void CefAppImpl::OnContextCreated(
     CefRefPtr<CefBrowser> browser,
     CefRefPtr<CefFrame> frame,
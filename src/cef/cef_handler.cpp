@@ -7,6 +7,12 @@
 
 #include "include/wrapper/cef_helpers.h"
 
+#ifdef __APPLE__
+#include <IOSurface/IOSurface.h>
+#endif
+
+#include <cstring>
+
 namespace html2ndi {
 
 CefHandler::CefHandler(int width, int height, FrameCallback callback)
@@ -44,20 +50,97 @@ void CefHandler::OnPaint(
     // Track paint timing
     auto now = std::chrono::steady_clock::now();
     if (paint_count_ > 0) {
-        auto interval = std::chrono::duration_cast<std::chrono::microseconds>(
-            now - last_paint_time_).count() / 1000.0;
-        double current_avg = avg_paint_interval_ms_.load();
-        avg_paint_interval_ms_ = 0.95 * current_avg + 0.05 * interval;
+        auto interval_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            now - last_paint_time_).count();
+        paint_histogram_.record(static_cast<uint64_t>(interval_us));
     }
     last_paint_time_ = now;
     paint_count_++;
     
-    // Forward frame to callback
+    // Forward frame to callback, translating CEF dirty rects so the
+    // pump can skip untouched rows instead of copying the full buffer
     if (frame_callback_) {
-        frame_callback_(buffer, width, height);
+        FrameRectList dirty;
+        dirty.reserve(dirtyRects.size());
+        for (const auto& rect : dirtyRects) {
+            dirty.push_back({rect.x, rect.y, rect.width, rect.height});
+        }
+        frame_callback_(buffer, width, height, dirty);
     }
 }
 
+void CefHandler::OnAcceleratedPaint(
+    CefRefPtr<CefBrowser> browser,
+    PaintElementType type,
+    const RectList& dirtyRects,
+    const CefAcceleratedPaintInfo& info) {
+
+    // Only handle main view, not popups
+    if (type != PET_VIEW) {
+        return;
+    }
+
+    // Track paint timing (same accounting as the software OSR path)
+    auto now = std::chrono::steady_clock::now();
+    if (paint_count_ > 0) {
+        auto interval_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            now - last_paint_time_).count();
+        paint_histogram_.record(static_cast<uint64_t>(interval_us));
+    }
+    last_paint_time_ = now;
+    paint_count_++;
+
+    if (!frame_callback_) {
+        return;
+    }
+
+#ifdef __APPLE__
+    // Chromium composited on the GPU into a shared IOSurface. Locking it
+    // maps the surface into our address space directly - no glReadPixels
+    // style readback - so the only cost left is the copy into the pump.
+    IOSurfaceRef surface = info.shared_texture_io_surface;
+    if (!surface) {
+        return;
+    }
+
+    if (IOSurfaceLock(surface, kIOSurfaceLockReadOnly, nullptr) != kIOReturnSuccess) {
+        LOG_WARNING("Failed to lock shared IOSurface");
+        return;
+    }
+
+    int width = static_cast<int>(IOSurfaceGetWidth(surface));
+    int height = static_cast<int>(IOSurfaceGetHeight(surface));
+    size_t stride = IOSurfaceGetBytesPerRow(surface);
+    const auto* base = static_cast<const uint8_t*>(IOSurfaceGetBaseAddress(surface));
+    const size_t row_bytes = static_cast<size_t>(width) * 4;
+
+    FrameRectList dirty;
+    dirty.reserve(dirtyRects.size());
+    for (const auto& rect : dirtyRects) {
+        dirty.push_back({rect.x, rect.y, rect.width, rect.height});
+    }
+
+    if (stride == row_bytes) {
+        // Tightly packed: hand the mapped surface straight to the pump
+        frame_callback_(base, width, height, dirty);
+    } else {
+        // Padded rows: repack into a reused staging buffer
+        accelerated_staging_.resize(row_bytes * height);
+        for (int y = 0; y < height; y++) {
+            std::memcpy(accelerated_staging_.data() + y * row_bytes,
+                        base + y * stride, row_bytes);
+        }
+        frame_callback_(accelerated_staging_.data(), width, height, dirty);
+    }
+
+    IOSurfaceUnlock(surface, kIOSurfaceLockReadOnly, nullptr);
+#else
+    (void)browser;
+    (void)dirtyRects;
+    (void)info;
+#endif
+}
+
 bool CefHandler::GetScreenInfo(
     CefRefPtr<CefBrowser> browser,
     CefScreenInfo& screen_info) {
@@ -191,15 +274,61 @@ bool CefHandler::OnConsoleMessage(
         default: break;
     }
     
-    LOG_DEBUG("[JS:%s] %s (%s:%d)", 
+    LOG_DEBUG("[JS:%s] %s (%s:%d)",
               level_str,
               message.ToString().c_str(),
               source.ToString().c_str(),
               line);
-    
+
     return false; // Don't suppress
 }
 
+void CefHandler::SetAudioCallbacks(AudioStartedCallback started,
+                                   AudioPacketCallback packet,
+                                   AudioStoppedCallback stopped) {
+    audio_started_callback_ = std::move(started);
+    audio_packet_callback_ = std::move(packet);
+    audio_stopped_callback_ = std::move(stopped);
+}
+
+void CefHandler::OnAudioStreamStarted(
+    CefRefPtr<CefBrowser> browser,
+    const CefAudioParameters& params,
+    int channels) {
+
+    LOG_DEBUG("Audio stream started: %d Hz, %d channels",
+              params.sample_rate, channels);
+    if (audio_started_callback_) {
+        audio_started_callback_(params.sample_rate, channels);
+    }
+}
+
+void CefHandler::OnAudioStreamPacket(
+    CefRefPtr<CefBrowser> browser,
+    const float** data,
+    int frames,
+    int64_t pts) {
+
+    // CEF's dedicated audio thread: forward and return, never block
+    if (audio_packet_callback_) {
+        audio_packet_callback_(data, frames);
+    }
+}
+
+void CefHandler::OnAudioStreamStopped(CefRefPtr<CefBrowser> browser) {
+    LOG_DEBUG("Audio stream stopped");
+    if (audio_stopped_callback_) {
+        audio_stopped_callback_();
+    }
+}
+
+void CefHandler::OnAudioStreamError(
+    CefRefPtr<CefBrowser> browser,
+    const CefString& message) {
+
+    LOG_WARNING("Audio stream error: %s", message.ToString().c_str());
+}
+
 // =============================================================================
 // Public methods
 // =============================================================================
@@ -225,12 +354,19 @@ std::string CefHandler::GetCurrentUrl() const {
 void CefHandler::Resize(int width, int height) {
     width_ = width;
     height_ = height;
-    
+
     std::lock_guard<std::mutex> lock(browser_mutex_);
     if (browser_) {
         browser_->GetHost()->WasResized();
     }
 }
 
+void CefHandler::SetFrameRate(int fps) {
+    std::lock_guard<std::mutex> lock(browser_mutex_);
+    if (browser_) {
+        browser_->GetHost()->SetWindowlessFrameRate(fps);
+    }
+}
+
 } // namespace html2ndi
 
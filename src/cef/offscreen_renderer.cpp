@@ -11,6 +11,7 @@
 #include "include/wrapper/cef_helpers.h"
 #include "include/wrapper/cef_library_loader.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <mach-o/dyld.h>
 
@@ -25,6 +26,14 @@ OffscreenRenderer::~OffscreenRenderer() {
     shutdown();
 }
 
+void OffscreenRenderer::set_audio_callbacks(AudioStartedCallback started,
+                                            AudioPacketCallback packet,
+                                            AudioStoppedCallback stopped) {
+    audio_started_callback_ = std::move(started);
+    audio_packet_callback_ = std::move(packet);
+    audio_stopped_callback_ = std::move(stopped);
+}
+
 bool OffscreenRenderer::initialize() {
     LOG_DEBUG("Initializing CEF...");
     
@@ -60,7 +69,11 @@ bool OffscreenRenderer::initialize() {
     settings.command_line_args_disabled = false;
     settings.remote_debugging_port = 0; // Disable remote debugging
     settings.log_severity = static_cast<cef_log_severity_t>(config_.cef_log_severity);
-    
+
+    // External message pump: CEF tells us when work is due via
+    // OnScheduleMessagePumpWork instead of us polling every millisecond
+    settings.external_message_pump = true;
+
     // Only set main_bundle_path - let CefScopedLibraryLoader handle the rest
     CefString(&settings.main_bundle_path).FromString(bundle_dir.string());
     
@@ -83,7 +96,10 @@ bool OffscreenRenderer::initialize() {
     
     // Initialize CEF
     CefRefPtr<CefAppImpl> app = new CefAppImpl();
-    
+    app->set_schedule_callback([this](int64_t delay_ms) {
+        schedule_pump_work(delay_ms);
+    });
+
     CefMainArgs main_args;
     if (!CefInitialize(main_args, settings, app, nullptr)) {
         LOG_ERROR("CefInitialize failed");
@@ -94,58 +110,143 @@ bool OffscreenRenderer::initialize() {
     
     // Create browser handler
     handler_ = new CefHandler(
-        config_.width, 
-        config_.height, 
+        config_.width,
+        config_.height,
         frame_callback_
     );
-    
+
+    // Audio capture must be wired before browser creation
+    if (audio_packet_callback_) {
+        handler_->SetAudioCallbacks(audio_started_callback_,
+                                    audio_packet_callback_,
+                                    audio_stopped_callback_);
+    }
+
+    if (!create_browser(handler_, config_.url, config_.fps)) {
+        return false;
+    }
+
+    initialized_ = true;
+    LOG_INFO("CEF renderer initialized");
+
+    return true;
+}
+
+bool OffscreenRenderer::create_browser(CefRefPtr<CefHandler> handler,
+                                       const std::string& url,
+                                       int frame_rate) {
     // Browser window info (off-screen)
     CefWindowInfo window_info;
     window_info.SetAsWindowless(0);
-    
+
+    // Accelerated OSR: Chromium composites into a shared IOSurface that we
+    // map directly in OnAcceleratedPaint, skipping the GPU->CPU readback
+    if (config_.cef_shared_textures) {
+        window_info.shared_texture_enabled = true;
+        LOG_INFO("Accelerated OSR enabled (shared textures)");
+    }
+
     // Browser settings
     CefBrowserSettings browser_settings;
-    browser_settings.windowless_frame_rate = config_.fps;
-    browser_settings.background_color = CefColorSetARGB(255, 0, 0, 0);
-    
+    browser_settings.windowless_frame_rate = frame_rate;
+    browser_settings.background_color = config_.alpha
+        ? CefColorSetARGB(0, 0, 0, 0)     // Transparent: alpha reaches OnPaint
+        : CefColorSetARGB(255, 0, 0, 0);  // Opaque black
+
     // JavaScript settings
     browser_settings.javascript = STATE_ENABLED;
     browser_settings.javascript_access_clipboard = STATE_DISABLED;
     browser_settings.javascript_dom_paste = STATE_DISABLED;
-    
+
     // Media settings
     browser_settings.webgl = STATE_ENABLED;
     browser_settings.remote_fonts = STATE_ENABLED;
-    
+
     // Memory management (plugins setting not available in CEF 120)
-    
+
     // Create browser
     LOG_DEBUG("Creating browser window...");
     if (!CefBrowserHost::CreateBrowser(
             window_info,
-            handler_,
-            config_.url,
+            handler,
+            url,
             browser_settings,
             nullptr,
             nullptr)) {
         LOG_ERROR("Failed to create browser");
         return false;
     }
-    
-    initialized_ = true;
-    LOG_INFO("CEF renderer initialized");
-    
+
     return true;
 }
 
+int OffscreenRenderer::create_stream(const std::string& url, int width, int height,
+                                     FrameCallback frame_callback) {
+    if (!initialized_) {
+        LOG_ERROR("create_stream called before CEF initialization");
+        return -1;
+    }
+
+    CefRefPtr<CefHandler> handler = new CefHandler(width, height,
+                                                   std::move(frame_callback));
+
+    if (!create_browser(handler, url, config_.fps)) {
+        return -1;
+    }
+
+    stream_handlers_.push_back(handler);
+    LOG_INFO("Created stream browser %zu (%dx%d): %s",
+             stream_handlers_.size(), width, height, url.c_str());
+    return static_cast<int>(stream_handlers_.size()) - 1;
+}
+
 void OffscreenRenderer::run_message_loop() {
     CefRunMessageLoop();
 }
 
 void OffscreenRenderer::do_message_loop_work() {
+    {
+        // This call services whatever is currently due; clear the
+        // schedule so the next wait blocks until CEF asks again
+        std::lock_guard<std::mutex> lock(pump_mutex_);
+        work_immediate_ = false;
+        next_work_time_ = std::chrono::steady_clock::time_point::max();
+    }
     CefDoMessageLoopWork();
 }
 
+void OffscreenRenderer::schedule_pump_work(int64_t delay_ms) {
+    std::lock_guard<std::mutex> lock(pump_mutex_);
+    if (delay_ms <= 0) {
+        work_immediate_ = true;
+    } else {
+        auto due = std::chrono::steady_clock::now() +
+                   std::chrono::milliseconds(delay_ms);
+        if (due < next_work_time_) {
+            next_work_time_ = due;
+        }
+    }
+    pump_cv_.notify_one();
+}
+
+void OffscreenRenderer::wait_for_work(std::chrono::milliseconds max_wait) {
+    std::unique_lock<std::mutex> lock(pump_mutex_);
+    const auto deadline = std::chrono::steady_clock::now() + max_wait;
+
+    for (;;) {
+        if (work_immediate_ || shutdown_requested_) {
+            return;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline || next_work_time_ <= now) {
+            return;
+        }
+        // Sleep until the earlier of CEF's requested time and our bound;
+        // schedule_pump_work wakes us early if new work arrives
+        pump_cv_.wait_until(lock, std::min(deadline, next_work_time_));
+    }
+}
+
 void OffscreenRenderer::shutdown() {
     if (!initialized_) {
         return;
@@ -155,19 +256,28 @@ void OffscreenRenderer::shutdown() {
     
     LOG_DEBUG("Shutting down CEF...");
     
-    // Close browser
+    // Close all browsers (primary plus any stream browsers)
+    std::vector<CefRefPtr<CefHandler>> handlers;
     if (handler_) {
-        auto browser = handler_->GetBrowser();
+        handlers.push_back(handler_);
+    }
+    handlers.insert(handlers.end(), stream_handlers_.begin(), stream_handlers_.end());
+
+    std::vector<CefRefPtr<CefHandler>> closing;
+    for (auto& handler : handlers) {
+        auto browser = handler->GetBrowser();
         if (browser) {
             browser->GetHost()->CloseBrowser(true);
-            
-            // Wait for browser to close
-            while (!handler_->IsBrowserClosed()) {
-                CefDoMessageLoopWork();
-            }
+            closing.push_back(handler);
         }
-        handler_ = nullptr;
     }
+    for (auto& handler : closing) {
+        while (!handler->IsBrowserClosed()) {
+            CefDoMessageLoopWork();
+        }
+    }
+    handler_ = nullptr;
+    stream_handlers_.clear();
     
     // Shutdown CEF
     CefShutdown();
@@ -215,6 +325,12 @@ void OffscreenRenderer::resize(int width, int height) {
     }
 }
 
+void OffscreenRenderer::set_frame_rate(int fps) {
+    if (handler_) {
+        handler_->SetFrameRate(fps);
+    }
+}
+
 std::string OffscreenRenderer::current_url() const {
     if (handler_) {
         return handler_->GetCurrentUrl();
@@ -231,6 +347,33 @@ void OffscreenRenderer::clear_cache() {
     LOG_INFO("Cache clearing requested (manual cleanup of cache directory required in CEF 120)");
 }
 
+void OffscreenRenderer::load_url(int stream_id, const std::string& url) {
+    if (stream_id < 0 || stream_id >= static_cast<int>(stream_handlers_.size())) {
+        return;
+    }
+    auto browser = stream_handlers_[stream_id]->GetBrowser();
+    if (browser) {
+        browser->GetMainFrame()->LoadURL(url);
+    }
+}
+
+void OffscreenRenderer::reload(int stream_id) {
+    if (stream_id < 0 || stream_id >= static_cast<int>(stream_handlers_.size())) {
+        return;
+    }
+    auto browser = stream_handlers_[stream_id]->GetBrowser();
+    if (browser) {
+        browser->Reload();
+    }
+}
+
+std::string OffscreenRenderer::current_url(int stream_id) const {
+    if (stream_id < 0 || stream_id >= static_cast<int>(stream_handlers_.size())) {
+        return "";
+    }
+    return stream_handlers_[stream_id]->GetCurrentUrl();
+}
+
 void OffscreenRenderer::notify_memory_pressure() {
     if (!initialized_ || !handler_) {
         return;
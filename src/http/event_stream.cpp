@@ -0,0 +1,116 @@
+/**
+ * Server-sent-events hub implementation.
+ */
+
+#include "html2ndi/http/event_stream.h"
+#include "html2ndi/utils/logger.h"
+
+#include <algorithm>
+
+namespace html2ndi {
+
+std::shared_ptr<EventStream::Client> EventStream::subscribe() {
+    auto client = std::make_shared<Client>();
+    enqueue(*client, "event: hello\ndata: {\"connected\": true}\n\n");
+
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    clients_.push_back(client);
+    LOG_DEBUG("SSE client subscribed (%zu total)", clients_.size());
+    return client;
+}
+
+void EventStream::unsubscribe(const std::shared_ptr<Client>& client) {
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        clients_.erase(std::remove(clients_.begin(), clients_.end(), client),
+                       clients_.end());
+    }
+    {
+        std::lock_guard<std::mutex> lock(client->mutex);
+        client->closed = true;
+    }
+    client->cv.notify_all();
+}
+
+void EventStream::publish(const std::string& event,
+                          const std::string& json_data) {
+    // Snapshot the subscriber list so a slow client's queue lock is never
+    // held while another subscribes
+    std::vector<std::shared_ptr<Client>> clients;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        if (clients_.empty()) {
+            return;
+        }
+        clients = clients_;
+    }
+
+    std::string frame;
+    frame.reserve(event.size() + json_data.size() + 16);
+    frame += "event: ";
+    frame += event;
+    frame += "\ndata: ";
+    frame += json_data;
+    frame += "\n\n";
+
+    for (auto& client : clients) {
+        enqueue(*client, frame);
+        client->cv.notify_one();
+    }
+    events_published_++;
+}
+
+void EventStream::enqueue(Client& client, const std::string& frame) {
+    std::lock_guard<std::mutex> lock(client.mutex);
+    if (client.closed) {
+        return;
+    }
+    // Drop-oldest: a dashboard that stops reading loses history, never
+    // the connection, and never blocks the publisher
+    if (client.queue.size() >= kQueueLimit) {
+        client.queue.pop_front();
+        client.dropped++;
+        events_dropped_++;
+    }
+    client.queue.push_back(frame);
+}
+
+bool EventStream::next(Client& client, std::string& out,
+                       std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(client.mutex);
+    client.cv.wait_for(lock, timeout, [&] {
+        return !client.queue.empty() || client.closed || shutdown_.load();
+    });
+
+    if (client.queue.empty()) {
+        return false;  // Timeout or close; caller checks closed/shutdown
+    }
+    out = std::move(client.queue.front());
+    client.queue.pop_front();
+    return true;
+}
+
+void EventStream::shutdown() {
+    shutdown_ = true;
+
+    std::vector<std::shared_ptr<Client>> clients;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        clients = clients_;
+        clients_.clear();
+    }
+    for (auto& client : clients) {
+        {
+            std::lock_guard<std::mutex> lock(client->mutex);
+            client->closed = true;
+        }
+        client->cv.notify_all();
+    }
+}
+
+size_t EventStream::client_count() const {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    return clients_.size();
+}
+
+} // namespace html2ndi
@@ -4,16 +4,27 @@
 
 #include "html2ndi/http/http_server.h"
 #include "html2ndi/application.h"
+#include "html2ndi/http/event_stream.h"
 #include "html2ndi/ndi/ndi_sender.h"
+#include "html2ndi/ndi/audio_pump.h"
 #include "html2ndi/ndi/frame_pump.h"
 #include "html2ndi/ndi/genlock.h"
+#include "html2ndi/ndi/pattern_generator.h"
+#include "html2ndi/ndi/proxy_stream.h"
 #include "html2ndi/utils/logger.h"
+#include "html2ndi/utils/image_encode.h"
+#include "html2ndi/utils/metrics.h"
+#include "html2ndi/utils/shm_preview.h"
+#include "html2ndi/utils/vt_jpeg_encoder.h"
+#include "html2ndi/utils/watchdog.h"
 
 #include <httplib.h>
 #include <nlohmann/json.hpp>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <thread>
 #include <mach-o/dyld.h>
 
 #ifdef __APPLE__
@@ -334,8 +345,15 @@ bool HttpServer::start() {
     
     // Give server time to start
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
+
     running_ = true;
+
+    // Refresh the pre-serialized /status snapshot off the request path
+    if (app_->config().status_interval_ms > 0) {
+        snapshot_running_ = true;
+        snapshot_thread_ = std::thread(&HttpServer::snapshot_loop, this);
+    }
+
     return true;
 }
 
@@ -345,7 +363,11 @@ void HttpServer::stop() {
     }
     
     LOG_DEBUG("Stopping HTTP server...");
-    
+
+    if (snapshot_running_.exchange(false) && snapshot_thread_.joinable()) {
+        snapshot_thread_.join();
+    }
+
     server_->stop();
     
     if (server_thread_.joinable()) {
@@ -360,6 +382,266 @@ std::string HttpServer::listen_url() const {
     return "http://" + host_ + ":" + std::to_string(port_);
 }
 
+std::string HttpServer::build_status_json() {
+    auto* ndi = app_->ndi_sender();
+    auto* pump = app_->frame_pump();
+
+    json status = {
+        {"url", app_->current_url()},
+        {"width", app_->config().width},
+        {"height", app_->config().height},
+        {"fps", app_->config().fps},
+        {"fps_n", pump ? pump->target_fps_n() : static_cast<int>(app_->config().fps)},
+        {"fps_d", pump ? pump->target_fps_d() : 1},
+        {"progressive", app_->config().progressive},
+        {"actual_fps", app_->current_fps()},
+        {"ndi_name", app_->config().ndi_name},
+        {"ndi_connections", app_->ndi_connection_count()},
+        {"ndi_metadata_received", ndi ? ndi->metadata_received() : 0},
+        {"streams", app_->stream_count()},
+        {"running", !app_->is_shutting_down()},
+        {"prewarmed", app_->prewarmed()},
+        {"resize_pending", pump ? pump->resize_pending() : false},
+        {"throttled", app_->render_throttled()},
+        {"time_to_first_frame_ms", app_->time_to_first_frame_ms()},
+        {"frames", {
+            {"sent", pump ? pump->frames_sent() : 0},
+            {"fields_sent", pump ? pump->fields_sent() : 0},
+            {"dropped", pump ? pump->frames_dropped() : 0},
+            {"held", pump ? pump->frames_held() : 0},
+            {"suspended", pump ? pump->frames_suspended() : 0},
+            {"duplicates", pump ? pump->duplicate_frames() : 0},
+            {"idle_skipped", pump ? pump->frames_idle_skipped() : 0},
+            {"idle_fps", pump ? pump->idle_fps() : 0},
+            {"drop_rate", pump ? pump->drop_rate() : 0.0}
+        }}
+    };
+
+    // Color settings (no sender while a warm spare idles)
+    if (ndi) {
+        status["color"] = {
+            {"colorspace", ndi->color_space_name()},
+            {"gamma", ndi->gamma_mode_name()},
+            {"range", ndi->color_range_name()},
+            {"format", ndi->pixel_format_name()},
+            {"alpha_mode", ndi->alpha_mode_name()}
+        };
+    }
+
+    // Warm-spare go-live latency, once measured
+    if (app_->activation_to_first_frame_ms() > 0.0) {
+        status["activation_to_first_frame_ms"] = app_->activation_to_first_frame_ms();
+    }
+
+    // Add genlock information if available
+    auto genlock = app_->genlock_clock();
+    if (genlock) {
+        std::string mode_str = "disabled";
+        switch (genlock->mode()) {
+            case GenlockMode::Master: mode_str = "master"; break;
+            case GenlockMode::Slave: mode_str = "slave"; break;
+            case GenlockMode::Disabled: mode_str = "disabled"; break;
+        }
+        
+        auto stats = genlock->get_stats();
+        status["genlock"] = {
+            {"mode", mode_str},
+            {"synchronized", genlock->is_synchronized()},
+            {"offset_us", genlock->sync_offset_us()},
+            {"phase_offset_us", genlock->phase_offset_us()},
+            {"stats", {
+                {"packets_sent", stats.sync_packets_sent},
+                {"packets_received", stats.sync_packets_received},
+                {"sync_failures", stats.sync_failures},
+                {"avg_offset_us", stats.avg_offset_us},
+                {"max_offset_us", stats.max_offset_us},
+                {"jitter_us", stats.jitter_us}
+            }}
+        };
+    } else {
+        status["genlock"] = {
+            {"mode", "disabled"},
+            {"synchronized", false}
+        };
+    }
+    
+    // Add genlocked status if available
+    status["genlocked"] = (genlock && genlock->mode() != GenlockMode::Disabled && genlock->is_synchronized());
+    
+    // Add performance metrics
+    if (pump) {
+        status["performance"] = {
+            {"buffer_size_bytes", pump->current_buffer_size()},
+            {"frame_pool_bytes", pump->pool_bytes()},
+            {"avg_submit_time_us", pump->avg_submit_time_us()},
+            {"avg_memcpy_time_us", pump->avg_memcpy_time_us()},
+            {"avg_full_copy_time_us", pump->avg_full_copy_time_us()},
+            {"avg_partial_copy_time_us", pump->avg_partial_copy_time_us()},
+            {"full_copies", pump->full_copy_count()},
+            {"partial_copies", pump->partial_copy_count()},
+            {"avg_jitter_us", pump->avg_jitter_us()},
+            {"max_jitter_us", pump->max_jitter_us()},
+            {"jitter_histogram", pump->jitter_histogram()},
+            {"jitter_histogram_bounds_us", FramePump::jitter_bucket_bounds_us()},
+            {"uptime_seconds", pump->uptime_seconds()},
+            {"bandwidth_mbps", pump->bandwidth_bytes_per_sec() / 1000000.0},
+            {"pipeline_latency_ms", pump->last_pipeline_latency_us() / 1000.0}
+        };
+    }
+
+    // Latency percentiles (HDR-style histograms); the averages above
+    // erase exactly the tail spikes these keep
+    auto histogram_json = [](const LatencyHistogram& h) {
+        const auto s = h.summary();
+        return json{
+            {"count", s.count},
+            {"p50", s.p50},
+            {"p99", s.p99},
+            {"p999", s.p999},
+            {"max", s.max}
+        };
+    };
+    json latency = json::object();
+    if (pump) {
+        latency["submit_us"] = histogram_json(pump->submit_histogram());
+        latency["memcpy_us"] = histogram_json(pump->memcpy_histogram());
+        latency["wakeup_us"] = histogram_json(pump->wakeup_histogram());
+        latency["pipeline_us"] = histogram_json(pump->pipeline_histogram());
+    }
+    if (const auto* paint = app_->paint_histogram()) {
+        latency["paint_interval_us"] = histogram_json(*paint);
+    }
+    if (!latency.empty()) {
+        status["latency"] = latency;
+    }
+    
+    // Config snapshot provenance (hot reload)
+    if (auto* store = app_->config_store()) {
+        status["config"] = {
+            {"generation", store->generation()},
+            {"reloads", store->reload_count()},
+            {"file", store->watched_file()}
+        };
+    }
+
+    // Stall profiler: heartbeat interval distribution and soft-stall count
+    if (auto* dog = app_->watchdog()) {
+        status["stalls"] = {
+            {"threshold_ms", dog->stall_threshold().count()},
+            {"count", dog->stall_count()},
+            {"max_interval_ms", dog->max_interval_ms()},
+            {"interval_histogram", dog->interval_histogram()},
+            {"interval_histogram_bounds_ms", Watchdog::interval_bucket_bounds_ms()}
+        };
+    }
+
+    // Audio capture pipeline (only when --audio is enabled)
+    if (auto* audio = app_->audio_pump()) {
+        status["audio"] = {
+            {"stream_active", audio->stream_active()},
+            {"sample_rate", audio->sample_rate()},
+            {"channels", audio->channels()},
+            {"packets", audio->packets_received()},
+            {"samples_sent", audio->frames_sent()},
+            {"samples_dropped", audio->frames_dropped()},
+            {"queued_ms", audio->queued_ms()},
+            {"av_offset_ms", audio->av_offset_ms()}
+        };
+    }
+
+    // Test-pattern source (only in --pattern mode)
+    if (auto* pattern = app_->pattern_generator()) {
+        status["pattern"] = {
+            {"frames_generated", pattern->frames_generated()},
+            {"avg_generate_time_us", pattern->avg_generate_time_us()}
+        };
+    }
+
+    // Low-bandwidth proxy output (--proxy or POST /proxy)
+    if (auto* proxy = app_->proxy_stream()) {
+        status["proxy"] = {
+            {"name", proxy->name()},
+            {"width", proxy->proxy_width()},
+            {"fps", proxy->proxy_fps()},
+            {"frames_sent", proxy->frames_sent()},
+            {"frames_skipped", proxy->frames_skipped()}
+        };
+    }
+
+    // SSE push channel (GET /events) subscriber stats
+    if (auto* events = app_->events()) {
+        status["events"] = {
+            {"clients", events->client_count()},
+            {"published", events->events_published()},
+            {"dropped", events->events_dropped()}
+        };
+    }
+
+    // Advertise the shm preview segment so a local supervisor can map it
+    if (auto* shm = app_->shm_preview()) {
+        status["shm_preview"] = {
+            {"name", shm->name()},
+            {"width", shm->preview_width()},
+            {"fps", shm->publish_fps()},
+            {"frames_published", shm->frames_published()}
+        };
+    }
+
+    // Add memory metrics (macOS specific)
+    #ifdef __APPLE__
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t size = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &size) == KERN_SUCCESS) {
+        status["memory"] = {
+            {"resident_size_mb", info.resident_size / 1024.0 / 1024.0},
+            {"virtual_size_mb", info.virtual_size / 1024.0 / 1024.0}
+        };
+    }
+    #endif
+
+    // Snapshot metadata so clients can judge staleness
+    const auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    status["snapshot"] = {
+        {"interval_ms", app_->config().status_interval_ms},
+        {"built_unix_ms", now_ms}
+    };
+
+    return status.dump(2);
+}
+
+std::shared_ptr<const std::string> HttpServer::status_snapshot() {
+    if (app_->config().status_interval_ms == 0) {
+        // Per-request mode: build fresh every time
+        return std::make_shared<const std::string>(build_status_json());
+    }
+
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    if (!snapshot_) {
+        // First request raced the snapshot thread's initial refresh
+        snapshot_ = std::make_shared<const std::string>(build_status_json());
+    }
+    return snapshot_;
+}
+
+void HttpServer::snapshot_loop() {
+    const auto interval = std::chrono::milliseconds(app_->config().status_interval_ms);
+
+    while (snapshot_running_) {
+        auto fresh = std::make_shared<const std::string>(build_status_json());
+        {
+            std::lock_guard<std::mutex> lock(snapshot_mutex_);
+            snapshot_ = std::move(fresh);
+        }
+
+        // Sleep in small steps so stop() is not delayed by a long interval
+        auto deadline = std::chrono::steady_clock::now() + interval;
+        while (snapshot_running_ && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
 void HttpServer::setup_routes() {
     // CORS headers
     auto add_cors = [](httplib::Response& res) {
@@ -374,95 +656,20 @@ void HttpServer::setup_routes() {
         res.status = 204;
     });
     
-    // GET /status - Get current status
+    // GET /metrics - Prometheus text exposition of the metrics registry
+    server_->Get("/metrics", [add_cors](const httplib::Request&, httplib::Response& res) {
+        add_cors(res);
+        res.set_content(MetricsRegistry::instance().render(),
+                        "text/plain; version=0.0.4; charset=utf-8");
+    });
+
+    // GET /status - Get current status. Served from a cached snapshot so
+    // Manager polling never touches the NDI SDK or the frame path.
     server_->Get("/status", [this, add_cors](const httplib::Request&, httplib::Response& res) {
         add_cors(res);
-        
-        auto* ndi = app_->ndi_sender();
-        auto* pump = app_->frame_pump();
-        
-        json status = {
-            {"url", app_->current_url()},
-            {"width", app_->config().width},
-            {"height", app_->config().height},
-            {"fps", app_->config().fps},
-            {"progressive", app_->config().progressive},
-            {"actual_fps", app_->current_fps()},
-            {"ndi_name", app_->config().ndi_name},
-            {"ndi_connections", app_->ndi_connection_count()},
-            {"running", !app_->is_shutting_down()},
-            {"color", {
-                {"colorspace", ndi->color_space_name()},
-                {"gamma", ndi->gamma_mode_name()},
-                {"range", ndi->color_range_name()}
-            }},
-            {"frames", {
-                {"sent", pump ? pump->frames_sent() : 0},
-                {"dropped", pump ? pump->frames_dropped() : 0},
-                {"held", pump ? pump->frames_held() : 0},
-                {"drop_rate", pump ? pump->drop_rate() : 0.0}
-            }}
-        };
-        
-        // Add genlock information if available
-        auto genlock = app_->genlock_clock();
-        if (genlock) {
-            std::string mode_str = "disabled";
-            switch (genlock->mode()) {
-                case GenlockMode::Master: mode_str = "master"; break;
-                case GenlockMode::Slave: mode_str = "slave"; break;
-                case GenlockMode::Disabled: mode_str = "disabled"; break;
-            }
-            
-            auto stats = genlock->get_stats();
-            status["genlock"] = {
-                {"mode", mode_str},
-                {"synchronized", genlock->is_synchronized()},
-                {"offset_us", genlock->sync_offset_us()},
-                {"stats", {
-                    {"packets_sent", stats.sync_packets_sent},
-                    {"packets_received", stats.sync_packets_received},
-                    {"sync_failures", stats.sync_failures},
-                    {"avg_offset_us", stats.avg_offset_us},
-                    {"max_offset_us", stats.max_offset_us},
-                    {"jitter_us", stats.jitter_us}
-                }}
-            };
-        } else {
-            status["genlock"] = {
-                {"mode", "disabled"},
-                {"synchronized", false}
-            };
-        }
-        
-        // Add genlocked status if available
-        status["genlocked"] = (genlock && genlock->mode() != GenlockMode::Disabled && genlock->is_synchronized());
-        
-        // Add performance metrics
-        if (pump) {
-            status["performance"] = {
-                {"buffer_size_bytes", pump->current_buffer_size()},
-                {"avg_submit_time_us", pump->avg_submit_time_us()},
-                {"avg_memcpy_time_us", pump->avg_memcpy_time_us()},
-                {"uptime_seconds", pump->uptime_seconds()},
-                {"bandwidth_mbps", pump->bandwidth_bytes_per_sec() / 1000000.0}
-            };
-        }
-        
-        // Add memory metrics (macOS specific)
-        #ifdef __APPLE__
-        struct mach_task_basic_info info;
-        mach_msg_type_number_t size = MACH_TASK_BASIC_INFO_COUNT;
-        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &size) == KERN_SUCCESS) {
-            status["memory"] = {
-                {"resident_size_mb", info.resident_size / 1024.0 / 1024.0},
-                {"virtual_size_mb", info.virtual_size / 1024.0 / 1024.0}
-            };
-        }
-        #endif
-        
-        res.set_content(status.dump(2), "application/json");
+        res.set_content(*status_snapshot(), "application/json");
     });
+
     
     // POST /seturl - Set URL to load
     server_->Post("/seturl", [this, add_cors](const httplib::Request& req, httplib::Response& res) {
@@ -495,6 +702,60 @@ void HttpServer::setup_routes() {
         }
     });
     
+    // POST /activate - Bring a warm spare (--prewarm) live: creates the
+    // NDI sender, starts the pump and navigates to the real URL
+    server_->Post("/activate", [this, add_cors](const httplib::Request& req, httplib::Response& res) {
+        add_cors(res);
+
+        try {
+            auto body = json::parse(req.body);
+
+            if (!body.contains("url") || !body["url"].is_string()) {
+                res.status = 400;
+                res.set_content(R"({"error": "Missing 'url' field"})", "application/json");
+                return;
+            }
+
+            std::string url = body["url"].get<std::string>();
+            std::string ndi_name;
+            if (body.contains("ndi_name") && body["ndi_name"].is_string()) {
+                ndi_name = body["ndi_name"].get<std::string>();
+            }
+
+            LOG_INFO("HTTP API: activate url=%s ndi_name=%s",
+                     url.c_str(), ndi_name.c_str());
+
+            if (!app_->activate(url, ndi_name)) {
+                res.status = 409;
+                res.set_content(R"({"error": "Worker is already live"})", "application/json");
+                return;
+            }
+
+            json response = {
+                {"success", true},
+                {"url", url},
+                {"ndi_name", ndi_name.empty() ? app_->config().ndi_name : ndi_name}
+            };
+            res.set_content(response.dump(), "application/json");
+
+        } catch (const json::exception& e) {
+            res.status = 400;
+            json error = {{"error", e.what()}};
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+
+    // POST /latency/reset - Zero the latency percentile histograms
+    server_->Post("/latency/reset", [this, add_cors](const httplib::Request&, httplib::Response& res) {
+        add_cors(res);
+
+        LOG_INFO("HTTP API: latency histogram reset");
+        app_->reset_latency_histograms();
+
+        json response = {{"success", true}};
+        res.set_content(response.dump(), "application/json");
+    });
+
     // POST /reload - Reload current page
     server_->Post("/reload", [this, add_cors](const httplib::Request&, httplib::Response& res) {
         add_cors(res);
@@ -542,25 +803,170 @@ void HttpServer::setup_routes() {
             quality = std::max(10, std::min(100, quality));
         }
         
-        std::vector<uint8_t> jpeg_data;
-        if (app_->get_thumbnail(jpeg_data, width, quality)) {
-            res.set_content(reinterpret_cast<const char*>(jpeg_data.data()), 
-                           jpeg_data.size(), "image/jpeg");
+        auto jpeg_data = app_->get_thumbnail(width, quality);
+        if (jpeg_data && !jpeg_data->empty()) {
+            res.set_content(reinterpret_cast<const char*>(jpeg_data->data()),
+                           jpeg_data->size(), "image/jpeg");
         } else {
             res.status = 503;
             res.set_content(R"({"error": "No frame available"})", "application/json");
         }
     });
-    
+
+    // GET /preview.mjpeg - Streaming MJPEG preview of the output frames.
+    // Each connection gets its own VideoToolbox encoder session; unchanged
+    // frames are re-sent from the last encode rather than re-encoded.
+    server_->Get("/preview.mjpeg", [this, add_cors](const httplib::Request& req, httplib::Response& res) {
+        add_cors(res);
+
+        // Parse optional fps, width and quality parameters
+        int fps = 15;
+        int width = 640;
+        int quality = 75;
+
+        if (req.has_param("fps")) {
+            fps = std::stoi(req.get_param_value("fps"));
+            fps = std::max(1, std::min(30, fps));
+        }
+        if (req.has_param("width")) {
+            width = std::stoi(req.get_param_value("width"));
+            width = std::max(64, std::min(1920, width)); // Clamp to reasonable range
+        }
+        if (req.has_param("quality")) {
+            quality = std::stoi(req.get_param_value("quality"));
+            quality = std::max(10, std::min(100, quality));
+        }
+
+        res.set_chunked_content_provider(
+            "multipart/x-mixed-replace; boundary=frame",
+            [this, fps, width, quality](size_t /*offset*/, httplib::DataSink& sink) {
+                VtJpegEncoder encoder;
+                std::vector<uint8_t> frame_data;
+                std::vector<uint8_t> scaled;
+                std::vector<uint8_t> jpeg;
+                uint64_t last_generation = 0;
+                bool have_frame = false;
+
+                const auto interval = std::chrono::nanoseconds(1000000000LL / fps);
+                auto next_frame = std::chrono::steady_clock::now();
+
+                while (!app_->is_shutting_down()) {
+                    auto* pump = app_->frame_pump();
+                    if (!pump) {
+                        break;
+                    }
+
+                    // Only re-encode when content has actually changed;
+                    // identical repaints keep the same content generation
+                    const uint64_t generation = pump->content_generation();
+                    if (!have_frame || generation != last_generation) {
+                        int frame_width = 0, frame_height = 0;
+                        if (pump->get_current_frame(frame_data, frame_width, frame_height)) {
+                            last_generation = generation;
+                            if (width > 0 && width < frame_width) {
+                                const int target_height = (frame_height * width) / frame_width;
+                                if (target_height >= 1) {
+                                    scaled.resize(static_cast<size_t>(width) * target_height * 4);
+                                    scale_bgra_box(frame_data.data(), frame_width, frame_height,
+                                                   scaled.data(), width, target_height);
+                                    have_frame = encoder.encode(scaled.data(), width, target_height,
+                                                                quality, jpeg);
+                                } else {
+                                    have_frame = encoder.encode(frame_data.data(), frame_width,
+                                                                frame_height, quality, jpeg);
+                                }
+                            } else {
+                                have_frame = encoder.encode(frame_data.data(), frame_width,
+                                                            frame_height, quality, jpeg);
+                            }
+                        }
+                    }
+
+                    if (have_frame) {
+                        char part_header[128];
+                        const int header_len = snprintf(
+                            part_header, sizeof(part_header),
+                            "--frame\r\nContent-Type: image/jpeg\r\nContent-Length: %zu\r\n\r\n",
+                            jpeg.size());
+                        if (!sink.write(part_header, header_len) ||
+                            !sink.write(reinterpret_cast<const char*>(jpeg.data()), jpeg.size()) ||
+                            !sink.write("\r\n", 2)) {
+                            return false; // Client disconnected
+                        }
+                    }
+
+                    next_frame += interval;
+                    const auto now = std::chrono::steady_clock::now();
+                    if (next_frame < now) {
+                        next_frame = now + interval; // Fell behind, resync
+                    }
+                    std::this_thread::sleep_until(next_frame);
+                }
+
+                sink.done();
+                return false;
+            });
+    });
+
+    // GET /events - Server-sent-events push channel. Status deltas, tally
+    // transitions, degradation warnings and frame-generation notifications
+    // are published from the main loop; each connection drains its own
+    // bounded queue, so a stalled client drops old events instead of
+    // blocking the publisher.
+    server_->Get("/events", [this, add_cors](const httplib::Request&, httplib::Response& res) {
+        add_cors(res);
+
+        auto client = app_->events()->subscribe();
+        res.set_header("Cache-Control", "no-cache");
+
+        res.set_chunked_content_provider(
+            "text/event-stream",
+            [this, client](size_t /*offset*/, httplib::DataSink& sink) {
+                std::string chunk;
+                while (!app_->is_shutting_down()) {
+                    if (app_->events()->next(*client, chunk,
+                                             std::chrono::milliseconds(500))) {
+                        if (!sink.write(chunk.data(), chunk.size())) {
+                            return false; // Client disconnected
+                        }
+                    } else {
+                        {
+                            std::lock_guard<std::mutex> lock(client->mutex);
+                            if (client->closed) {
+                                break;
+                            }
+                        }
+                        // Idle: keep intermediaries from timing out the
+                        // connection with an SSE comment
+                        if (!sink.write(": keepalive\n\n", 13)) {
+                            return false;
+                        }
+                    }
+                }
+                sink.done();
+                return false;
+            },
+            [this, client](bool /*success*/) {
+                app_->events()->unsubscribe(client);
+            });
+    });
+
     // GET /color - Get current color settings
     server_->Get("/color", [this, add_cors](const httplib::Request&, httplib::Response& res) {
         add_cors(res);
         
         auto* ndi = app_->ndi_sender();
+        if (!ndi) {
+            res.status = 409;
+            res.set_content(R"({"error": "No NDI sender (worker is prewarmed)"})", "application/json");
+            return;
+        }
         json response = {
             {"colorspace", ndi->color_space_name()},
             {"gamma", ndi->gamma_mode_name()},
             {"range", ndi->color_range_name()},
+            {"format", ndi->pixel_format_name()},
+            {"alpha_mode", ndi->alpha_mode_name()},
             {"presets", {"rec709", "rec2020", "srgb", "rec601"}}
         };
         res.set_content(response.dump(2), "application/json");
@@ -573,7 +979,12 @@ void HttpServer::setup_routes() {
         try {
             auto body = json::parse(req.body);
             auto* ndi = app_->ndi_sender();
-            
+            if (!ndi) {
+                res.status = 409;
+                res.set_content(R"({"error": "No NDI sender (worker is prewarmed)"})", "application/json");
+                return;
+            }
+
             // Apply preset if specified
             if (body.contains("preset") && body["preset"].is_string()) {
                 std::string preset = body["preset"].get<std::string>();
@@ -625,12 +1036,52 @@ void HttpServer::setup_routes() {
                 if (rg == "full") ndi->set_color_range(ColorRange::Full);
                 else if (rg == "limited") ndi->set_color_range(ColorRange::Limited);
             }
-            
+
+            if (body.contains("format") && body["format"].is_string()) {
+                std::string fmt = body["format"].get<std::string>();
+                if (fmt == "bgra") {
+                    ndi->set_pixel_format(PixelFormat::BGRX);
+                    LOG_INFO("HTTP API: pixel format set to bgra");
+                } else if (fmt == "uyvy") {
+                    ndi->set_pixel_format(PixelFormat::UYVY);
+                    LOG_INFO("HTTP API: pixel format set to uyvy");
+                } else if (fmt == "alpha") {
+                    ndi->set_pixel_format(PixelFormat::BGRA);
+                    LOG_INFO("HTTP API: pixel format set to alpha (BGRA)");
+                    if (!app_->config().alpha) {
+                        // The page background is fixed at browser creation,
+                        // so without --alpha the channel is fully opaque
+                        LOG_WARNING("Alpha format enabled without --alpha: page background stays opaque");
+                    }
+                } else {
+                    res.status = 400;
+                    res.set_content(R"({"error": "Unknown format. Use: bgra, uyvy, alpha"})", "application/json");
+                    return;
+                }
+            }
+
+            if (body.contains("alpha_mode") && body["alpha_mode"].is_string()) {
+                std::string mode = body["alpha_mode"].get<std::string>();
+                if (mode == "premultiplied") {
+                    ndi->set_alpha_mode(AlphaMode::Premultiplied);
+                    LOG_INFO("HTTP API: alpha mode set to premultiplied");
+                } else if (mode == "straight") {
+                    ndi->set_alpha_mode(AlphaMode::Straight);
+                    LOG_INFO("HTTP API: alpha mode set to straight");
+                } else {
+                    res.status = 400;
+                    res.set_content(R"({"error": "Unknown alpha_mode. Use: premultiplied, straight"})", "application/json");
+                    return;
+                }
+            }
+
             json response = {
                 {"success", true},
                 {"colorspace", ndi->color_space_name()},
                 {"gamma", ndi->gamma_mode_name()},
-                {"range", ndi->color_range_name()}
+                {"range", ndi->color_range_name()},
+                {"format", ndi->pixel_format_name()},
+                {"alpha_mode", ndi->alpha_mode_name()}
             };
             res.set_content(response.dump(), "application/json");
             
@@ -640,7 +1091,309 @@ void HttpServer::setup_routes() {
             res.set_content(error.dump(), "application/json");
         }
     });
-    
+
+    // POST /framerate - Change the output framerate at runtime.
+    // Accepts {"fps": "59.94"}, {"fps": "60000/1001"} or {"fps": 60};
+    // an optional "idle_fps" integer sets the static-content keepalive rate.
+    server_->Post("/framerate", [this, add_cors](const httplib::Request& req, httplib::Response& res) {
+        add_cors(res);
+
+        try {
+            auto body = json::parse(req.body);
+
+            const bool have_fps = body.contains("fps");
+            std::string fps_str;
+            if (have_fps && body["fps"].is_string()) {
+                fps_str = body["fps"].get<std::string>();
+            } else if (have_fps && body["fps"].is_number()) {
+                char buf[32];
+                snprintf(buf, sizeof(buf), "%.3f", body["fps"].get<double>());
+                fps_str = buf;
+            }
+
+            int num = 0, den = 1;
+            if (have_fps && !Config::parse_framerate(fps_str, num, den)) {
+                res.status = 400;
+                res.set_content(R"({"error": "Invalid framerate. Use e.g. 60, 59.94 or 60000/1001"})", "application/json");
+                return;
+            }
+
+            auto* pump = app_->frame_pump();
+            if (!pump) {
+                res.status = 503;
+                res.set_content(R"({"error": "Frame pump not available"})", "application/json");
+                return;
+            }
+            if (have_fps) {
+                pump->set_target_fps(num, den);
+            }
+
+            if (body.contains("idle_fps") && body["idle_fps"].is_number_integer()) {
+                int idle = body["idle_fps"].get<int>();
+                if (idle < 0) {
+                    res.status = 400;
+                    res.set_content(R"({"error": "idle_fps must be >= 0"})", "application/json");
+                    return;
+                }
+                pump->set_idle_fps(idle);
+                LOG_INFO("HTTP API: idle keepalive rate set to %d fps", idle);
+            }
+
+            json response = {
+                {"success", true},
+                {"fps_n", pump->target_fps_n()},
+                {"fps_d", pump->target_fps_d()},
+                {"fps", static_cast<double>(pump->target_fps_n()) / pump->target_fps_d()},
+                {"idle_fps", pump->idle_fps()}
+            };
+            res.set_content(response.dump(), "application/json");
+
+        } catch (const json::exception& e) {
+            res.status = 400;
+            json error = {{"error", e.what()}};
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+
+    // POST /resolution - Seamless runtime resolution change. The stream
+    // keeps repeating the last old-size frame until the first new-size
+    // paint lands, then flips dimensions on a frame boundary.
+    server_->Post("/resolution", [this, add_cors](const httplib::Request& req, httplib::Response& res) {
+        add_cors(res);
+
+        try {
+            auto body = json::parse(req.body);
+
+            if (!body.contains("width") || !body["width"].is_number_integer() ||
+                !body.contains("height") || !body["height"].is_number_integer()) {
+                res.status = 400;
+                res.set_content(R"({"error": "width and height (integers) are required"})", "application/json");
+                return;
+            }
+
+            const int width = body["width"].get<int>();
+            const int height = body["height"].get<int>();
+            if (width < 16 || width > 7680 || height < 16 || height > 4320) {
+                res.status = 400;
+                res.set_content(R"({"error": "Resolution must be between 16x16 and 7680x4320"})", "application/json");
+                return;
+            }
+
+            if (!app_->resize(width, height)) {
+                res.status = 409;
+                res.set_content(R"({"error": "No browser to resize (pattern mode)"})", "application/json");
+                return;
+            }
+
+            LOG_INFO("HTTP API: resolution change to %dx%d", width, height);
+
+            json response = {
+                {"success", true},
+                {"width", width},
+                {"height", height},
+                {"resize_pending", app_->frame_pump() &&
+                                   app_->frame_pump()->resize_pending()}
+            };
+            res.set_content(response.dump(), "application/json");
+
+        } catch (const json::exception& e) {
+            res.status = 400;
+            json error = {{"error", e.what()}};
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+
+    // POST /proxy - Toggle the low-bandwidth ".proxy" monitoring output
+    server_->Post("/proxy", [this, add_cors](const httplib::Request& req, httplib::Response& res) {
+        add_cors(res);
+
+        try {
+            auto body = json::parse(req.body);
+
+            if (!body.contains("enabled") || !body["enabled"].is_boolean()) {
+                res.status = 400;
+                res.set_content(R"({"error": "enabled (boolean) is required"})", "application/json");
+                return;
+            }
+
+            if (!body["enabled"].get<bool>()) {
+                app_->disable_proxy();
+                LOG_INFO("HTTP API: proxy stream disabled");
+                res.set_content(R"({"success": true, "enabled": false})", "application/json");
+                return;
+            }
+
+            int width = static_cast<int>(app_->config().proxy_width);
+            int fps = static_cast<int>(app_->config().proxy_fps);
+            if (body.contains("width") && body["width"].is_number_integer()) {
+                width = body["width"].get<int>();
+            }
+            if (body.contains("fps") && body["fps"].is_number_integer()) {
+                fps = body["fps"].get<int>();
+            }
+            if (width < 64 || width > 1920 || fps < 1 || fps > 60) {
+                res.status = 400;
+                res.set_content(R"({"error": "width must be 64-1920 and fps 1-60"})", "application/json");
+                return;
+            }
+
+            if (!app_->enable_proxy(width, fps)) {
+                res.status = 409;
+                res.set_content(R"({"error": "Cannot start proxy (no primary sender yet)"})", "application/json");
+                return;
+            }
+
+            auto* proxy = app_->proxy_stream();
+            LOG_INFO("HTTP API: proxy stream enabled (%d px, %d fps)",
+                     proxy->proxy_width(), proxy->proxy_fps());
+            json response = {
+                {"success", true},
+                {"enabled", true},
+                {"name", proxy->name()},
+                {"width", proxy->proxy_width()},
+                {"fps", proxy->proxy_fps()}
+            };
+            res.set_content(response.dump(), "application/json");
+
+        } catch (const json::exception& e) {
+            res.status = 400;
+            json error = {{"error", e.what()}};
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+
+    // GET /streams - List additional streams (multi-stream mode)
+    server_->Get("/streams", [this, add_cors](const httplib::Request&, httplib::Response& res) {
+        add_cors(res);
+
+        json streams = json::array();
+        for (size_t i = 0; i < app_->stream_count(); i++) {
+            auto* pump = app_->stream_pump(i);
+            auto* sender = app_->stream_sender(i);
+            streams.push_back({
+                {"index", i},
+                {"ndi_name", app_->stream_name(i)},
+                {"url", app_->stream_url(i)},
+                {"actual_fps", pump ? pump->actual_fps() : 0.0f},
+                {"frames_sent", pump ? pump->frames_sent() : 0},
+                {"connections", sender ? sender->get_connection_count() : 0}
+            });
+        }
+
+        json response = {
+            {"count", app_->stream_count()},
+            {"streams", streams}
+        };
+        res.set_content(response.dump(2), "application/json");
+    });
+
+    // POST /streams/<n>/url - Navigate a stream to a new URL
+    server_->Post(R"(/streams/(\d+)/url)", [this, add_cors](const httplib::Request& req, httplib::Response& res) {
+        add_cors(res);
+
+        const size_t index = std::stoul(req.matches[1]);
+        if (index >= app_->stream_count()) {
+            res.status = 404;
+            res.set_content(R"({"error": "No such stream"})", "application/json");
+            return;
+        }
+
+        try {
+            auto body = json::parse(req.body);
+            if (!body.contains("url") || !body["url"].is_string()) {
+                res.status = 400;
+                res.set_content(R"({"error": "Missing 'url' field"})", "application/json");
+                return;
+            }
+
+            std::string url = body["url"].get<std::string>();
+            app_->stream_set_url(index, url);
+
+            json response = {
+                {"success", true},
+                {"index", index},
+                {"url", url}
+            };
+            res.set_content(response.dump(), "application/json");
+
+        } catch (const json::exception& e) {
+            res.status = 400;
+            json error = {{"error", e.what()}};
+            res.set_content(error.dump(), "application/json");
+        }
+    });
+
+    // POST /streams/<n>/reload - Reload a stream's page
+    server_->Post(R"(/streams/(\d+)/reload)", [this, add_cors](const httplib::Request& req, httplib::Response& res) {
+        add_cors(res);
+
+        const size_t index = std::stoul(req.matches[1]);
+        if (index >= app_->stream_count()) {
+            res.status = 404;
+            res.set_content(R"({"error": "No such stream"})", "application/json");
+            return;
+        }
+
+        app_->stream_reload(index);
+
+        json response = {
+            {"success", true},
+            {"index", index},
+            {"url", app_->stream_url(index)}
+        };
+        res.set_content(response.dump(), "application/json");
+    });
+
+    // GET /streams/<n>/thumbnail - JPEG thumbnail of a stream's current frame
+    server_->Get(R"(/streams/(\d+)/thumbnail)", [this, add_cors](const httplib::Request& req, httplib::Response& res) {
+        add_cors(res);
+
+        const size_t index = std::stoul(req.matches[1]);
+        auto* pump = app_->stream_pump(index);
+        if (!pump) {
+            res.status = 404;
+            res.set_content(R"({"error": "No such stream"})", "application/json");
+            return;
+        }
+
+        int width = 320;
+        int quality = 75;
+        if (req.has_param("width")) {
+            width = std::stoi(req.get_param_value("width"));
+            width = std::max(64, std::min(1920, width));
+        }
+        if (req.has_param("quality")) {
+            quality = std::stoi(req.get_param_value("quality"));
+            quality = std::max(10, std::min(100, quality));
+        }
+
+        std::vector<uint8_t> frame_data;
+        int frame_width = 0, frame_height = 0;
+        if (!pump->get_current_frame(frame_data, frame_width, frame_height)) {
+            res.status = 503;
+            res.set_content(R"({"error": "No frame available"})", "application/json");
+            return;
+        }
+
+        std::vector<uint8_t> jpeg;
+        bool ok;
+        if (width > 0 && width < frame_width) {
+            ok = encode_jpeg_scaled(frame_data.data(), frame_width, frame_height,
+                                    width, quality, jpeg);
+        } else {
+            ok = encode_jpeg(frame_data.data(), frame_width, frame_height,
+                             quality, jpeg);
+        }
+        if (!ok) {
+            res.status = 500;
+            res.set_content(R"({"error": "Encode failed"})", "application/json");
+            return;
+        }
+
+        res.set_content(reinterpret_cast<const char*>(jpeg.data()),
+                        jpeg.size(), "image/jpeg");
+    });
+
     // GET /genlock - Get genlock status
     server_->Get("/genlock", [this, add_cors](const httplib::Request&, httplib::Response& res) {
         add_cors(res);
@@ -668,6 +1421,7 @@ void HttpServer::setup_routes() {
             {"mode", mode_str},
             {"synchronized", genlock->is_synchronized()},
             {"offset_us", genlock->sync_offset_us()},
+            {"phase_offset_us", genlock->phase_offset_us()},
             {"available", true},
             {"stats", {
                 {"packets_sent", stats.sync_packets_sent},
@@ -725,7 +1479,28 @@ void HttpServer::setup_routes() {
                 LOG_INFO("HTTP API: changing genlock master to %s", address.c_str());
                 genlock->set_master_address(address);
             }
-            
+
+            // Pin the sub-frame send-slot phase offset (overrides the
+            // master's automatic stagger assignment)
+            if (body.contains("phase_us")) {
+                if (!body["phase_us"].is_number_integer()) {
+                    res.status = 400;
+                    json error = {{"error", "phase_us must be an integer"}};
+                    res.set_content(error.dump(), "application/json");
+                    return;
+                }
+                int64_t phase_us = body["phase_us"].get<int64_t>();
+                if (phase_us < 0 || phase_us > 100000) {
+                    res.status = 400;
+                    json error = {{"error", "phase_us must be 0-100000"}};
+                    res.set_content(error.dump(), "application/json");
+                    return;
+                }
+                LOG_INFO("HTTP API: pinning genlock phase offset to %lld us",
+                         static_cast<long long>(phase_us));
+                genlock->set_phase_offset_us(phase_us);
+            }
+
             // Get current status
             std::string current_mode = "disabled";
             switch (genlock->mode()) {
@@ -0,0 +1,188 @@
+/**
+ * Audio pump implementation.
+ */
+
+#include "html2ndi/ndi/audio_pump.h"
+#include "html2ndi/utils/logger.h"
+#include "html2ndi/utils/watchdog.h"
+
+#include <algorithm>
+
+namespace html2ndi {
+
+namespace {
+
+// Ring holds about one second of audio so capture bursts and drain
+// hiccups never meet; rounded up so index masking works
+uint64_t round_up_pow2(uint64_t value) {
+    uint64_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+AudioPump::AudioPump(AudioSink sink, int fps_n, int fps_d)
+    : sink_(std::move(sink))
+    , drain_interval_(static_cast<int64_t>(1000000) * fps_d / fps_n) {
+}
+
+AudioPump::~AudioPump() {
+    stop();
+}
+
+void AudioPump::start() {
+    if (running_) {
+        return;
+    }
+
+    running_ = true;
+    thread_ = std::thread(&AudioPump::drain_thread, this);
+    LOG_INFO("Audio pump started (drain interval: %lld us)",
+             static_cast<long long>(drain_interval_.count()));
+}
+
+void AudioPump::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    LOG_INFO("Audio pump stopped (packets: %llu, sent: %llu samples, dropped: %llu samples)",
+             static_cast<unsigned long long>(packets_received_.load()),
+             static_cast<unsigned long long>(frames_sent_.load()),
+             static_cast<unsigned long long>(frames_dropped_.load()));
+}
+
+void AudioPump::on_stream_started(int sample_rate, int channels) {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+
+    // Gate the producer while the ring is resized; CEF delivers the first
+    // packet only after this returns, but a restarted stream may race a
+    // drain tick still working through leftovers
+    stream_active_.store(false, std::memory_order_release);
+
+    sample_rate_ = sample_rate;
+    channels_ = channels;
+
+    ring_capacity_ = round_up_pow2(static_cast<uint64_t>(sample_rate));
+    ring_mask_ = ring_capacity_ - 1;
+    ring_.assign(ring_capacity_ * channels, 0.0f);
+    planar_scratch_.assign(ring_capacity_ * channels, 0.0f);
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    av_offset_ms_ = 0.0;
+
+    stream_active_.store(true, std::memory_order_release);
+    LOG_INFO("Audio stream started: %d Hz, %d channels (ring: %llu samples)",
+             sample_rate, channels,
+             static_cast<unsigned long long>(ring_capacity_));
+}
+
+void AudioPump::push_packet(const float** data, int frames) {
+    // CEF audio thread: wait-free, no locks, no allocation
+    if (!stream_active_.load(std::memory_order_acquire) || frames <= 0) {
+        return;
+    }
+
+    const int channels = channels_.load(std::memory_order_relaxed);
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    const uint64_t free_frames = ring_capacity_ - (tail - head);
+
+    const uint64_t n = std::min<uint64_t>(static_cast<uint64_t>(frames), free_frames);
+    if (n < static_cast<uint64_t>(frames)) {
+        // Ring full: drop the overflow rather than block capture
+        frames_dropped_ += static_cast<uint64_t>(frames) - n;
+    }
+
+    // Interleave into the ring; planar again at drain time
+    for (uint64_t i = 0; i < n; i++) {
+        float* slot = &ring_[((tail + i) & ring_mask_) * channels];
+        for (int ch = 0; ch < channels; ch++) {
+            slot[ch] = data[ch][i];
+        }
+    }
+
+    tail_.store(tail + n, std::memory_order_release);
+    packets_received_++;
+}
+
+void AudioPump::on_stream_stopped() {
+    stream_active_.store(false, std::memory_order_release);
+    LOG_INFO("Audio stream stopped");
+}
+
+uint64_t AudioPump::queued_frames() const {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+double AudioPump::queued_ms() const {
+    const int rate = sample_rate_.load(std::memory_order_relaxed);
+    if (rate <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(queued_frames()) * 1000.0 / rate;
+}
+
+void AudioPump::drain_thread() {
+    LOG_DEBUG("Audio pump thread started");
+    Watchdog::register_current_thread("audio");
+
+    while (running_) {
+        drain_available();
+        std::this_thread::sleep_for(drain_interval_);
+    }
+
+    // Flush whatever capture queued before the stream/pump stopped
+    drain_available();
+
+    Watchdog::unregister_current_thread();
+    LOG_DEBUG("Audio pump thread exited");
+}
+
+void AudioPump::drain_available() {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    const uint64_t available = tail - head;
+    if (available == 0) {
+        return;
+    }
+
+    const int channels = channels_.load(std::memory_order_relaxed);
+    const int rate = sample_rate_.load(std::memory_order_relaxed);
+
+    // A/V offset: how far behind video this batch went out. The queue
+    // depth at drain time is exactly the capture-to-send latency.
+    if (rate > 0) {
+        const double offset = static_cast<double>(available) * 1000.0 / rate;
+        av_offset_ms_ = 0.9 * av_offset_ms_.load() + 0.1 * offset;
+    }
+
+    // De-interleave into the planar layout send_audio_frame expects
+    for (int ch = 0; ch < channels; ch++) {
+        float* out = &planar_scratch_[static_cast<size_t>(ch) * available];
+        for (uint64_t i = 0; i < available; i++) {
+            out[i] = ring_[((head + i) & ring_mask_) * channels + ch];
+        }
+    }
+
+    if (sink_) {
+        sink_(planar_scratch_.data(), rate, channels,
+              static_cast<int>(available));
+    }
+
+    head_.store(head + available, std::memory_order_release);
+    frames_sent_ += available;
+}
+
+} // namespace html2ndi
@@ -4,29 +4,163 @@
  */
 
 #include "html2ndi/ndi/frame_pump.h"
+#include "html2ndi/ndi/pixel_convert.h"
 #include "html2ndi/utils/logger.h"
+#include "html2ndi/utils/watchdog.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <mach/mach_time.h>
+#endif
 
 namespace html2ndi {
 
+namespace {
+
+// xxh3-style multiply-xor hash over one row of pixels. Four independent
+// 64-bit lanes keep the multiplies pipelined, so the loop runs close to
+// memory bandwidth. The seed carries the row index so identical rows at
+// different positions do not cancel when frame hashes are XOR-combined.
+uint64_t hash_row(const uint8_t* data, size_t bytes, uint64_t seed) {
+    constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+
+    uint64_t lanes[4] = {seed + kPrime1, seed + kPrime2,
+                         seed ^ kPrime1, seed ^ kPrime2};
+    size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        uint64_t v[4];
+        std::memcpy(v, data + i, 32);
+        for (int l = 0; l < 4; l++) {
+            lanes[l] = (lanes[l] ^ v[l]) * kPrime1;
+        }
+    }
+
+    uint64_t h = lanes[0];
+    h = (h ^ lanes[1]) * kPrime1;
+    h = (h ^ lanes[2]) * kPrime1;
+    h = (h ^ lanes[3]) * kPrime1;
+
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t v;
+        std::memcpy(&v, data + i, 8);
+        h = (h ^ v) * kPrime2;
+    }
+    for (; i < bytes; i++) {
+        h = (h ^ data[i]) * kPrime2;
+    }
+
+    // Final avalanche so low-entropy pixel data spreads across all bits
+    h ^= h >> 29;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 32;
+    return h;
+}
+
+} // anonymous namespace
+
+FramePump::FrameStorage::~FrameStorage() {
+    if (data_) {
+        munlock(data_, capacity_);
+        std::free(data_);
+    }
+}
+
+void FramePump::FrameStorage::reserve(size_t bytes) {
+    if (bytes <= capacity_) {
+        return;
+    }
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t new_capacity = (bytes + page - 1) / page * page;
+
+    void* mem = nullptr;
+    if (posix_memalign(&mem, page, new_capacity) != 0) {
+        throw std::bad_alloc();
+    }
+
+    // Pin the pages so the frame path never takes a fault mid-copy.
+    // Best-effort: over the RLIMIT_MEMLOCK cap we just run unpinned.
+    if (mlock(mem, new_capacity) != 0) {
+        LOG_DEBUG("mlock failed for %zu-byte frame buffer (running unpinned)",
+                  new_capacity);
+    }
+
+    if (size_ > 0) {
+        std::memcpy(mem, data_, size_);
+    }
+    if (data_) {
+        munlock(data_, capacity_);
+        std::free(data_);
+    }
+    data_ = static_cast<uint8_t*>(mem);
+    capacity_ = new_capacity;
+}
+
+void FramePump::FrameStorage::resize(size_t bytes) {
+    reserve(bytes);
+    size_ = bytes;
+}
+
+void FramePump::FrameStorage::swap(FrameStorage& other) {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+}
+
 FramePump::FramePump(NdiSender* sender, int target_fps, bool progressive, std::shared_ptr<GenlockClock> genlock_clock)
     : sender_(sender)
-    , target_fps_(target_fps)
+    , target_fps_n_(target_fps)
+    , target_fps_d_(1)
     , progressive_(progressive)
     , genlock_clock_(genlock_clock) {
-    
+
     // Calculate frame duration
     frame_duration_ = std::chrono::nanoseconds(1'000'000'000 / target_fps);
-    
-    // Pre-allocate frame buffers to prevent fragmentation
-    // Reserve for 4K resolution (3840 x 2160 x 4 bytes BGRA)
-    size_t max_frame_size = 3840 * 2160 * 4;
-    buffers_[0].data.reserve(max_frame_size);
-    buffers_[1].data.reserve(max_frame_size);
-    
-    LOG_DEBUG("Frame buffers pre-allocated: %zu bytes each", max_frame_size);
+}
+
+void FramePump::preallocate(int width, int height) {
+    const size_t frame_size = static_cast<size_t>(width) * height * 4;
+
+    std::lock_guard<std::mutex> lock(alloc_mutex_);
+    size_t total = 0;
+    for (auto& buffer : buffers_) {
+        buffer.data.resize(frame_size);
+        buffer.data.resize(0); // Keep capacity, stay "no frame yet" for readers
+        total += buffer.data.capacity();
+    }
+    pool_bytes_ = total;
+
+    LOG_DEBUG("Frame buffer pool pre-allocated: %zu bytes for %dx%d",
+              total, width, height);
+}
+
+void FramePump::prepare_resize(int width, int height) {
+    const size_t frame_size = static_cast<size_t>(width) * height * 4;
+
+    // Allocate and pin replacement storage here, off the frame path. The
+    // buffers themselves cannot be grown from this thread - the writer and
+    // the pump use them lock-free - so the writer swaps these in as it
+    // reaches each buffer.
+    std::lock_guard<std::mutex> lock(alloc_mutex_);
+    staged_storage_.clear();
+    for (size_t i = 0; i < 3; i++) {
+        auto storage = std::make_unique<FrameStorage>();
+        storage->reserve(frame_size);
+        staged_storage_.push_back(std::move(storage));
+    }
+
+    pending_resize_height_.store(height);
+    pending_resize_width_.store(width);
+
+    LOG_INFO("Resize staged: %dx%d pool pre-allocated, holding last frame "
+             "until the first new-size paint", width, height);
 }
 
 FramePump::~FramePump() {
@@ -38,17 +172,20 @@ void FramePump::start() {
         return;
     }
     
-    LOG_DEBUG("Starting frame pump at %d fps%s", 
-              target_fps_.load(),
+    LOG_DEBUG("Starting frame pump at %.3f fps%s%s",
+              static_cast<double>(target_fps_n_.load()) / target_fps_d_.load(),
+              progressive_.load() ? "" : " (interlaced, field-rate cadence)",
               genlock_clock_ ? " (GENLOCKED)" : "");
-    
+
     running_ = true;
     start_time_ = get_current_time();
     fps_start_ = start_time_;
     fps_frame_count_ = 0;
     frames_sent_ = 0;
+    fields_sent_ = 0;
     frames_dropped_ = 0;
     frames_held_ = 0;
+    frames_suspended_ = 0;
     
     thread_ = std::thread(&FramePump::pump_thread, this);
 }
@@ -71,50 +208,208 @@ void FramePump::stop() {
               frames_sent_.load(), frames_dropped_.load(), frames_held_.load());
 }
 
-void FramePump::submit_frame(const void* data, int width, int height) {
+int FramePump::merge_row_spans(std::vector<RowSpan>& spans) {
+    if (spans.empty()) {
+        return 0;
+    }
+
+    std::sort(spans.begin(), spans.end(),
+              [](const RowSpan& a, const RowSpan& b) { return a.top < b.top; });
+
+    size_t out = 0;
+    for (size_t i = 1; i < spans.size(); i++) {
+        if (spans[i].top <= spans[out].bottom) {
+            spans[out].bottom = std::max(spans[out].bottom, spans[i].bottom);
+        } else {
+            spans[++out] = spans[i];
+        }
+    }
+    spans.resize(out + 1);
+
+    int rows = 0;
+    for (const auto& span : spans) {
+        rows += span.bottom - span.top;
+    }
+    return rows;
+}
+
+void FramePump::submit_frame(const void* data, int width, int height,
+                             const FrameRectList& dirty_rects) {
     if (!running_) {
         return;
     }
-    
+
     auto start_time = std::chrono::high_resolution_clock::now();
-    
+
     // Track current dimensions for bandwidth calculation
     current_width_ = width;
     current_height_ = height;
-    
-    // Get write buffer
-    int write_idx = write_buffer_.load();
-    FrameBuffer& buffer = buffers_[write_idx];
-    
+
+    // Get write buffer (writer-private, no other thread touches it)
+    FrameBuffer& buffer = buffers_[write_index_];
+
     // Copy frame data
     size_t size = width * height * 4; // RGBA
-    
-    {
-        std::lock_guard<std::mutex> lock(buffer_mutex_);
-        
-        if (buffer.data.size() != size) {
-            buffer.data.resize(size);
+    const size_t row_bytes = static_cast<size_t>(width) * 4;
+
+    // Collapse dirty rects to row spans clipped to the frame. Rows touched
+    // by previous frames landed in other buffers, so this buffer must also
+    // heal its recorded stale rows to stay a complete frame.
+    std::vector<RowSpan> spans;
+    spans.reserve(dirty_rects.size() + buffer.stale_rows.size());
+    for (const auto& rect : dirty_rects) {
+        int top = std::max(0, rect.y);
+        int bottom = std::min(height, rect.y + rect.height);
+        if (top < bottom) {
+            spans.push_back({top, bottom});
         }
-        
-        auto memcpy_start = std::chrono::high_resolution_clock::now();
+    }
+    std::vector<RowSpan> new_spans = spans; // Rows the other buffers will be missing
+    merge_row_spans(new_spans);             // Each row at most once (hashing below)
+
+    // Update the content hash over exactly the rows this submit touches.
+    // An unchanged frame hash means CEF repainted identical pixels, in
+    // which case the copy and the publish can be skipped entirely.
+    const uint8_t* src_bytes = static_cast<const uint8_t*>(data);
+    const bool dims_changed = row_hashes_.size() != static_cast<size_t>(height) ||
+                              hashed_width_ != width;
+    const bool rehash_all = dims_changed || new_spans.empty();
+    uint64_t frame_hash = frame_hash_;
+    if (rehash_all) {
+        row_hashes_.assign(height, 0);
+        hashed_width_ = width;
+        frame_hash = 0;
+        for (int y = 0; y < height; y++) {
+            row_hashes_[y] = hash_row(src_bytes + y * row_bytes, row_bytes,
+                                      static_cast<uint64_t>(y));
+            frame_hash ^= row_hashes_[y];
+        }
+    } else {
+        for (const auto& span : new_spans) {
+            for (int y = span.top; y < span.bottom; y++) {
+                uint64_t h = hash_row(src_bytes + y * row_bytes, row_bytes,
+                                      static_cast<uint64_t>(y));
+                frame_hash ^= row_hashes_[y] ^ h;
+                row_hashes_[y] = h;
+            }
+        }
+    }
+
+    const bool content_changed = frame_hash != frame_hash_;
+    frame_hash_ = frame_hash;
+    content_hash_.store(frame_hash);
+    if (content_changed) {
+        content_generation_++;
+    }
+
+    if (!content_changed && !dims_changed && frame_generation_ > 0) {
+        // Identical repaint: the published pipeline already holds exactly
+        // this content at this size, so nothing downstream can tell the
+        // difference. Count it and bail before touching any buffer.
+        duplicate_frames_++;
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto submit_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            end_time - start_time).count();
+        submit_histogram_.record(static_cast<uint64_t>(submit_us));
+        return;
+    }
+
+    bool full_copy = true;
+    if (buffer.data.size() == size && buffer.primed && !spans.empty()) {
+        spans.insert(spans.end(), buffer.stale_rows.begin(), buffer.stale_rows.end());
+        int dirty_total = merge_row_spans(spans);
+        // Past ~half the frame a single memcpy beats the bookkeeping
+        full_copy = dirty_total * 2 >= height;
+    }
+
+    // Seqlock write section: odd version while the buffer is inconsistent
+    buffer.version.fetch_add(1, std::memory_order_acq_rel);
+
+    if (buffer.data.size() != size) {
+        // Reallocation is the only operation that can invalidate a
+        // concurrent thumbnail copy, so it alone takes the lock
+        std::lock_guard<std::mutex> lock(alloc_mutex_);
+        // A staged resize parked pre-pinned storage for exactly this
+        // moment: swap it in (O(1)) instead of allocating mid-stream.
+        // The displaced old-size storage is released here - munlock and
+        // free only, no copy.
+        if (!staged_storage_.empty() &&
+            staged_storage_.back()->capacity() >= size) {
+            buffer.data.swap(*staged_storage_.back());
+            staged_storage_.pop_back();
+        }
+        buffer.data.resize(size);
+        pool_bytes_ = buffers_[0].data.capacity() + buffers_[1].data.capacity() +
+                      buffers_[2].data.capacity();
+    }
+
+    auto memcpy_start = std::chrono::high_resolution_clock::now();
+    if (full_copy) {
         std::memcpy(buffer.data.data(), data, size);
-        auto memcpy_end = std::chrono::high_resolution_clock::now();
-        
-        // Track memcpy time (exponential moving average)
-        auto memcpy_us = std::chrono::duration_cast<std::chrono::microseconds>(
-            memcpy_end - memcpy_start).count();
-        double current_avg = avg_memcpy_time_us_.load();
-        avg_memcpy_time_us_ = 0.9 * current_avg + 0.1 * memcpy_us;
-        
-        buffer.width = width;
-        buffer.height = height;
-        buffer.ready = true;
+    } else {
+        const uint8_t* src = static_cast<const uint8_t*>(data);
+        for (const auto& span : spans) {
+            size_t offset = static_cast<size_t>(span.top) * row_bytes;
+            std::memcpy(buffer.data.data() + offset, src + offset,
+                        static_cast<size_t>(span.bottom - span.top) * row_bytes);
+        }
     }
-    
-    // Swap buffers
-    write_buffer_.store(1 - write_idx);
-    read_buffer_.store(write_idx);
-    
+    auto memcpy_end = std::chrono::high_resolution_clock::now();
+
+    // Track copy times, split by copy type
+    auto memcpy_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        memcpy_end - memcpy_start).count();
+    memcpy_histogram_.record(static_cast<uint64_t>(memcpy_us));
+    if (full_copy) {
+        avg_full_copy_time_us_ = 0.9 * avg_full_copy_time_us_.load() + 0.1 * memcpy_us;
+        full_copy_count_++;
+    } else {
+        avg_partial_copy_time_us_ = 0.9 * avg_partial_copy_time_us_.load() + 0.1 * memcpy_us;
+        partial_copy_count_++;
+    }
+
+    buffer.stale_rows.clear();
+    buffer.primed = true;
+    buffer.width = width;
+    buffer.height = height;
+    // Stamp the frame with the moment CEF handed it over; the pump reads
+    // this at send time for the paint-to-send latency measurement
+    buffer.capture_time = std::chrono::steady_clock::now();
+
+    buffer.version.fetch_add(1, std::memory_order_acq_rel);
+
+    // Record which rows the other buffers are now missing. A resize or an
+    // empty dirty list means we cannot track deltas, so force them to take
+    // a full copy next time around. This metadata is writer-private.
+    for (auto& other : buffers_) {
+        if (&other == &buffer) {
+            continue;
+        }
+        if (other.data.size() == size && !new_spans.empty()) {
+            other.stale_rows.insert(other.stale_rows.end(),
+                                    new_spans.begin(), new_spans.end());
+            merge_row_spans(other.stale_rows);
+        } else {
+            other.primed = false;
+            other.stale_rows.clear();
+        }
+    }
+
+    // Publish: hand the finished buffer to the shared slot (marked fresh)
+    // and take back whichever buffer was parked there
+    int previous = shared_.exchange(write_index_ | kFreshBit);
+    write_index_ = previous & kIndexMask;
+    frame_generation_++;
+
+    // First frame at a staged resize's dimensions: the pump picks it up on
+    // its next frame boundary, so the output flips size atomically there
+    if (pending_resize_width_.load() == width &&
+        pending_resize_height_.load() == height) {
+        pending_resize_width_.store(0);
+        pending_resize_height_.store(0);
+        LOG_INFO("Resize complete: first %dx%d frame published", width, height);
+    }
+
     // Notify pump thread
     buffer_cv_.notify_one();
     
@@ -122,13 +417,29 @@ void FramePump::submit_frame(const void* data, int width, int height) {
     auto end_time = std::chrono::high_resolution_clock::now();
     auto submit_us = std::chrono::duration_cast<std::chrono::microseconds>(
         end_time - start_time).count();
-    double current_avg = avg_submit_time_us_.load();
-    avg_submit_time_us_ = 0.9 * current_avg + 0.1 * submit_us;
+    submit_histogram_.record(static_cast<uint64_t>(submit_us));
 }
 
 void FramePump::set_target_fps(int fps) {
-    target_fps_ = fps;
-    frame_duration_ = std::chrono::nanoseconds(1'000'000'000 / fps);
+    set_target_fps(fps, 1);
+}
+
+void FramePump::set_target_fps(int num, int den) {
+    if (num < 1 || den < 1) {
+        LOG_WARNING("Ignoring invalid framerate %d/%d", num, den);
+        return;
+    }
+    target_fps_n_ = num;
+    target_fps_d_ = den;
+    frame_duration_ = std::chrono::nanoseconds(1'000'000'000LL * den / num);
+}
+
+void FramePump::set_idle_fps(int fps) {
+    if (fps < 0) {
+        LOG_WARNING("Ignoring invalid idle framerate %d", fps);
+        return;
+    }
+    idle_fps_ = fps;
 }
 
 float FramePump::actual_fps() const {
@@ -137,98 +448,302 @@ float FramePump::actual_fps() const {
 
 void FramePump::pump_thread() {
     LOG_DEBUG("Frame pump thread started");
-    
-    auto next_frame_time = get_current_time();
-    int fps = target_fps_.load();
-    auto frame_duration = std::chrono::nanoseconds(1'000'000'000 / fps);
-    
+    Watchdog::register_current_thread("pump");
+
+    // Interlaced output runs the schedule at field rate: two ticks per
+    // frame period, alternating field 0 / field 1, each send carrying half
+    // the rows. Progressive mode keeps the multiplier at 1.
+    const bool interlaced = !progressive_.load();
+    const int rate_mult = interlaced ? 2 : 1;
+    bool top_field = true;
+
+    int fps_n = target_fps_n_.load();
+    int fps_d = target_fps_d_.load();
+    auto frame_duration = std::chrono::nanoseconds(
+        1'000'000'000LL * fps_d / (static_cast<int64_t>(fps_n) * rate_mult));
+
+    // Absolute schedule: frame N is due at schedule_epoch + N * den / num
+    // seconds, computed with exact integer arithmetic per frame. A late
+    // wakeup delays that one frame without shifting the cadence of every
+    // frame after it, so the long-run rate stays exactly on target even
+    // for fractional rates like 60000/1001.
+    auto schedule_epoch = get_current_time();
+    uint64_t frame_number = 0;
+    auto next_frame_time = schedule_epoch;
+
+    // Idle keepalive bookkeeping
+    auto last_new_frame_time = get_current_time();
+    auto last_send_time = get_current_time() - frame_duration;
+
     while (running_) {
         // Wait for next frame time
         auto now = get_current_time();
         if (now < next_frame_time) {
-            std::unique_lock<std::mutex> lock(buffer_mutex_);
-            buffer_cv_.wait_until(lock, next_frame_time, [this] {
-                return !running_;
-            });
-            
+            wait_until_deadline(next_frame_time);
             if (!running_) break;
         }
-        
+
+        // How late did we wake relative to the absolute deadline?
+        record_jitter(get_current_time() - next_frame_time);
+
         // Get current frame rate and duration
-        fps = target_fps_.load();
-        frame_duration = std::chrono::nanoseconds(1'000'000'000 / fps);
-        
+        int new_fps_n = target_fps_n_.load();
+        int new_fps_d = target_fps_d_.load();
+        if (new_fps_n != fps_n || new_fps_d != fps_d) {
+            // Rate change: restart the schedule at the new cadence
+            fps_n = new_fps_n;
+            fps_d = new_fps_d;
+            frame_duration = std::chrono::nanoseconds(
+                1'000'000'000LL * fps_d / (static_cast<int64_t>(fps_n) * rate_mult));
+            schedule_epoch = get_current_time();
+            frame_number = 0;
+        }
+
         // Calculate next frame time
         if (genlock_clock_ && genlock_clock_->mode() != GenlockMode::Disabled) {
             // Use genlock for frame-accurate synchronization
             next_frame_time = genlock_clock_->next_frame_boundary(
                 get_current_time(), frame_duration);
         } else {
-            // Standard timing
-            next_frame_time = get_current_time() + frame_duration;
+            frame_number++;
+
+            // num ticks span exactly den seconds (2x num in interlaced
+            // mode); fold whole cycles into the epoch so the product
+            // below cannot overflow
+            while (frame_number >= static_cast<uint64_t>(fps_n) * rate_mult) {
+                schedule_epoch += std::chrono::seconds(fps_d);
+                frame_number -= static_cast<uint64_t>(fps_n) * rate_mult;
+            }
+            next_frame_time = schedule_epoch + std::chrono::nanoseconds(
+                static_cast<int64_t>(frame_number) * 1'000'000'000LL * fps_d /
+                (static_cast<int64_t>(fps_n) * rate_mult));
+
+            // If we fell far behind (stall, debugger, system sleep), rebase
+            // the schedule instead of bursting frames to catch up
+            if (get_current_time() - next_frame_time > 4 * frame_duration) {
+                schedule_epoch = get_current_time();
+                frame_number = 0;
+                next_frame_time = schedule_epoch;
+            }
         }
-        
-        // Get read buffer
-        int read_idx = read_buffer_.load();
-        FrameBuffer& buffer = buffers_[read_idx];
-        
-        // Check if we have a frame to send
-        {
-            std::lock_guard<std::mutex> lock(buffer_mutex_);
-            
-            // Determine which frame to send: new or held
-            bool send_new_frame = buffer.ready;
-            bool can_send_frame = send_new_frame || (!buffer.data.empty() && buffer.width > 0 && buffer.height > 0);
-            
-            if (!can_send_frame) {
-                // Truly no frame available (startup condition before first frame)
-                frames_dropped_++;
+
+        // Take the freshest frame if the writer published one since last tick;
+        // otherwise keep holding the current read buffer (frame repeat)
+        bool send_new_frame = false;
+        if (shared_.load(std::memory_order_acquire) & kFreshBit) {
+            int previous = shared_.exchange(read_index_);
+            read_index_ = previous & kIndexMask;
+            read_index_published_.store(read_index_);
+            send_new_frame = true;
+        }
+
+        FrameBuffer& buffer = buffers_[read_index_];
+
+        if (buffer.data.empty() || buffer.width == 0 || buffer.height == 0) {
+            // Truly no frame available (startup condition before first frame)
+            frames_dropped_++;
+            continue;
+        }
+
+        auto tick_time = get_current_time();
+        if (send_new_frame) {
+            last_new_frame_time = tick_time;
+        }
+
+        // Zero-receiver suspension: nobody is listening, so skip the SDK
+        // send (and its mutex) entirely. The buffer exchange above still
+        // ran, so the tick after a receiver connects transmits the
+        // current full frame - reconnect latency stays at one frame.
+        if (sender_ && !sender_->has_receivers()) {
+            frames_suspended_++;
+            continue;
+        }
+
+        // Idle policy: once content has been static for over a second,
+        // re-send the held frame at the keepalive rate instead of the full
+        // target rate. A fresh frame exits idle immediately, so the policy
+        // only ever suppresses redundant repeats of a parked page.
+        const int idle_fps = idle_fps_.load();
+        if (idle_fps > 0 && !send_new_frame &&
+            tick_time - last_new_frame_time >= std::chrono::seconds(1)) {
+            auto keepalive = std::chrono::nanoseconds(1'000'000'000LL / idle_fps);
+            if (tick_time - last_send_time < keepalive) {
+                frames_idle_skipped_++;
                 continue;
             }
-            
-            // Track frame hold if repeating previous frame
-            if (!send_new_frame) {
-                frames_held_++;
+        }
+
+        // Track frame hold if repeating previous frame
+        if (!send_new_frame) {
+            frames_held_++;
+        }
+        last_send_time = tick_time;
+
+        // Send frame to NDI (new or repeated for seamless output).
+        // The writer cannot touch this buffer until we exchange it back,
+        // so no lock is held across the send.
+        if (sender_) {
+            auto saved_timecode = sender_->get_timecode_mode();
+
+            if (genlock_clock_ && genlock_clock_->mode() != GenlockMode::Disabled) {
+                sender_->set_timecode(genlock_clock_->get_ndi_timecode());
             }
-            
-            // Send frame to NDI (new or repeated for seamless output)
-            if (sender_) {
-                auto saved_timecode = sender_->get_timecode_mode();
-                
-                if (genlock_clock_ && genlock_clock_->mode() != GenlockMode::Disabled) {
-                    sender_->set_timecode(genlock_clock_->get_ndi_timecode());
+
+            // Paint-to-send latency: the age of these pixels right now.
+            // Recorded only on a frame's first transmission - a held frame
+            // is old by design - but every send carries the capture time
+            // as the NDI timestamp so receivers see true pipeline age.
+            int64_t ndi_timestamp = 0;
+            if (buffer.capture_time.time_since_epoch().count() != 0) {
+                const auto age = std::chrono::steady_clock::now() -
+                                 buffer.capture_time;
+                if (send_new_frame) {
+                    const int64_t age_us =
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                            age).count();
+                    pipeline_histogram_.record(static_cast<uint64_t>(
+                        std::max<int64_t>(age_us, 0)));
+                    last_pipeline_latency_us_ = age_us;
                 }
-                
+                const auto capture_utc =
+                    std::chrono::system_clock::now() -
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(age);
+                ndi_timestamp = std::chrono::duration_cast<
+                    std::chrono::duration<int64_t, std::ratio<1, 10000000>>>(
+                    capture_utc.time_since_epoch()).count();
+            }
+
+            if (interlaced) {
+                // Extract this tick's field and send it at field rate.
+                // Both fields of a held frame come from the same buffer;
+                // fresh content picked up between fields lands in the
+                // later field, which is exactly interlaced temporal order.
+                const int field_height =
+                    (buffer.height + (top_field ? 1 : 0)) / 2;
+                field_scratch_.resize(
+                    static_cast<size_t>(buffer.width) * field_height * 4);
+                bgra_extract_field(buffer.data.data(), buffer.width,
+                                   buffer.height, top_field,
+                                   field_scratch_.data());
+                sender_->send_video_field(
+                    field_scratch_.data(),
+                    buffer.width,
+                    field_height,
+                    fps_n * 2,
+                    fps_d,
+                    top_field,
+                    ndi_timestamp
+                );
+            } else {
                 sender_->send_video_frame(
                     buffer.data.data(),
                     buffer.width,
                     buffer.height,
-                    fps,
-                    1,
-                    progressive_
+                    fps_n,
+                    fps_d,
+                    progressive_,
+                    ndi_timestamp
                 );
-                
-                sender_->set_timecode_mode(saved_timecode);
             }
-            
-            // Mark new frame as consumed
-            if (send_new_frame) {
-                buffer.ready = false;
+
+            sender_->set_timecode_mode(saved_timecode);
+        }
+        // Note: Frame hold (repeating) is NOT counted as dropped
+        // The stream continues seamlessly at target framerate
+
+        if (interlaced) {
+            fields_sent_++;
+            // A frame completes on its bottom field, so frames_sent_ and
+            // the measured fps stay in frame units
+            if (!top_field) {
+                frames_sent_++;
+                fps_frame_count_++;
             }
-            // Note: Frame hold (repeating) is NOT counted as dropped
-            // The stream continues seamlessly at target framerate
+            top_field = !top_field;
+        } else {
+            frames_sent_++;
+            fps_frame_count_++;
         }
-        
-        frames_sent_++;
-        fps_frame_count_++;
-        
+
         // Update FPS counter
         update_fps_counter();
     }
     
+    Watchdog::unregister_current_thread();
     LOG_DEBUG("Frame pump thread exited");
 }
 
+void FramePump::wait_until_deadline(std::chrono::steady_clock::time_point deadline) {
+#ifdef __APPLE__
+    // Two-stage wait: coarse sleep on the condition variable until ~1 ms
+    // before the deadline so stop() can still interrupt promptly, then
+    // finish with mach_wait_until, whose absolute-deadline wakeups are an
+    // order of magnitude tighter than wait_until on this platform.
+    auto coarse_deadline = deadline - std::chrono::milliseconds(1);
+    if (get_current_time() < coarse_deadline) {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        buffer_cv_.wait_until(lock, coarse_deadline, [this] {
+            return !running_;
+        });
+    }
+    if (!running_) {
+        return;
+    }
+
+    auto remaining = deadline - get_current_time();
+    if (remaining > std::chrono::nanoseconds::zero()) {
+        static mach_timebase_info_data_t timebase = [] {
+            mach_timebase_info_data_t info;
+            mach_timebase_info(&info);
+            return info;
+        }();
+        const uint64_t remaining_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count());
+        mach_wait_until(mach_absolute_time() +
+                        remaining_ns * timebase.denom / timebase.numer);
+    }
+#else
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    buffer_cv_.wait_until(lock, deadline, [this] {
+        return !running_;
+    });
+#endif
+}
+
+void FramePump::record_jitter(std::chrono::nanoseconds lateness) {
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(lateness).count();
+    if (us < 0) {
+        us = 0; // Early wakeups only happen on stop/rate change
+    }
+
+    wakeup_histogram_.record(static_cast<uint64_t>(us));
+
+    const auto& bounds = jitter_bucket_bounds_us();
+    int bucket = kJitterBuckets - 1;
+    for (int i = 0; i < kJitterBuckets - 1; i++) {
+        if (us < bounds[i]) {
+            bucket = i;
+            break;
+        }
+    }
+    jitter_buckets_[bucket]++;
+}
+
+std::array<uint64_t, FramePump::kJitterBuckets> FramePump::jitter_histogram() const {
+    std::array<uint64_t, kJitterBuckets> counts;
+    for (int i = 0; i < kJitterBuckets; i++) {
+        counts[i] = jitter_buckets_[i].load();
+    }
+    return counts;
+}
+
+const std::array<int64_t, FramePump::kJitterBuckets - 1>& FramePump::jitter_bucket_bounds_us() {
+    static const std::array<int64_t, kJitterBuckets - 1> bounds = {
+        50, 100, 250, 500, 1000, 2500, 5000
+    };
+    return bounds;
+}
+
 void FramePump::update_fps_counter() {
     auto now = get_current_time();
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -269,20 +784,38 @@ std::chrono::steady_clock::time_point FramePump::get_current_time() const {
 }
 
 bool FramePump::get_current_frame(std::vector<uint8_t>& out_data, int& out_width, int& out_height) const {
-    // Get the most recently written buffer
-    int read_idx = read_buffer_.load();
-    const FrameBuffer& buffer = buffers_[read_idx];
-    
-    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(buffer_mutex_));
-    
-    if (buffer.data.empty() || buffer.width == 0 || buffer.height == 0) {
-        return false;
+    // Seqlock read: copy the buffer the pump last published, then verify the
+    // writer did not reclaim and mutate it mid-copy. Retries are rare since
+    // the writer has two other buffers to cycle through.
+    for (int attempt = 0; attempt < 4; attempt++) {
+        int read_idx = read_index_published_.load();
+        const FrameBuffer& buffer = buffers_[read_idx];
+
+        uint32_t version = buffer.version.load(std::memory_order_acquire);
+        if (version & 1) {
+            continue; // Writer mid-update
+        }
+
+        if (buffer.data.empty() || buffer.width == 0 || buffer.height == 0) {
+            return false;
+        }
+
+        {
+            // Hold the allocation lock so the vector cannot be reallocated
+            // under us; the frame path only takes it on a resolution change
+            std::lock_guard<std::mutex> lock(alloc_mutex_);
+            out_data.assign(buffer.data.data(),
+                            buffer.data.data() + buffer.data.size());
+        }
+        out_width = buffer.width;
+        out_height = buffer.height;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (buffer.version.load(std::memory_order_relaxed) == version) {
+            return true;
+        }
     }
-    
-    out_data = buffer.data;
-    out_width = buffer.width;
-    out_height = buffer.height;
-    return true;
+    return false;
 }
 
 double FramePump::uptime_seconds() const {
@@ -307,14 +840,15 @@ double FramePump::drop_rate() const {
 uint64_t FramePump::bandwidth_bytes_per_sec() const {
     int width = current_width_.load();
     int height = current_height_.load();
-    int fps = target_fps_.load();
-    
+    int fps_n = target_fps_n_.load();
+    int fps_d = target_fps_d_.load();
+
     // BGRA = 4 bytes per pixel
-    return static_cast<uint64_t>(width) * height * 4 * fps;
+    return static_cast<uint64_t>(width) * height * 4 * fps_n / fps_d;
 }
 
 size_t FramePump::current_buffer_size() const {
-    int read_idx = read_buffer_.load();
+    int read_idx = read_index_published_.load();
     const FrameBuffer& buffer = buffers_[read_idx];
     return buffer.data.size();
 }
@@ -7,31 +7,118 @@
 
 #include <arpa/inet.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <unistd.h>
 #include <cstring>
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace html2ndi {
 
-// Genlock sync packet structure
+// Packet types for the PTP-style exchange
+enum : uint32_t {
+    kPacketSync = 0,          // Master -> slaves, carries master send time
+    kPacketDelayRequest = 1,  // Slave -> master, carries slave send time
+    kPacketDelayResponse = 2, // Master -> slave, echoes request + master rx time
+};
+
+// Genlock sync packet structure (version 3 adds the phase-slot stagger
+// assignment carried in delay responses; v2 peers are not wire-compatible)
 struct GenlockPacket {
     uint32_t magic{0x474E4C4B};  // 'GNLK'
-    uint32_t version{1};
-    int64_t timestamp_ns;        // Master timestamp in nanoseconds
-    int64_t frame_number;        // Frame counter
+    uint32_t version{3};
+    uint32_t type{kPacketSync};
     uint32_t fps;                // Framerate
+    int64_t timestamp_ns;        // Sync: master send time. DelayRequest:
+                                 // slave send time (echoed back in response)
+    int64_t receive_ns;          // DelayResponse: master kernel rx time of the request
+    int64_t frame_number;        // Frame counter
+    uint32_t phase_slot{0};      // DelayResponse: this slave's stagger slot
+    uint32_t phase_slot_count{0}; // DelayResponse: total slots (master = slot 0)
     uint32_t checksum;           // Simple checksum
-    
+
     uint32_t calculate_checksum() const {
-        return magic ^ version ^ static_cast<uint32_t>(timestamp_ns) ^
-               static_cast<uint32_t>(frame_number) ^ fps;
+        return magic ^ version ^ type ^ fps ^
+               static_cast<uint32_t>(timestamp_ns) ^
+               static_cast<uint32_t>(receive_ns) ^
+               static_cast<uint32_t>(frame_number) ^
+               phase_slot ^ phase_slot_count;
     }
-    
+
     bool validate() const {
-        return magic == 0x474E4C4B && checksum == calculate_checksum();
+        return magic == 0x474E4C4B && version == 3 &&
+               checksum == calculate_checksum();
     }
 };
 
+// Split "ip:port" (port optional, default 5960) into its parts
+static void parse_address(const std::string& address, std::string& ip, int& port) {
+    ip = address;
+    port = 5960;
+    size_t colon_pos = address.find(':');
+    if (colon_pos != std::string::npos) {
+        ip = address.substr(0, colon_pos);
+        port = std::stoi(address.substr(colon_pos + 1));
+    }
+}
+
+// True for addresses in the IPv4 multicast range (224.0.0.0 - 239.255.255.255)
+static bool is_multicast_address(const std::string& ip) {
+    struct in_addr addr{};
+    if (inet_pton(AF_INET, ip.c_str(), &addr) != 1) {
+        return false;
+    }
+    return (ntohl(addr.s_addr) >> 28) == 0xE;
+}
+
+// Receive a packet with its kernel SO_TIMESTAMP arrival time mapped onto the
+// steady timeline. The kernel stamps against the wall clock, so the queueing
+// delay (wall now - wall stamp) is subtracted from steady now; this removes
+// the scheduler jitter a plain recvfrom + steady_clock::now() pair carries.
+static ssize_t recv_with_timestamp(int fd, GenlockPacket& packet,
+                                   struct sockaddr_in& src_addr, int flags,
+                                   std::chrono::steady_clock::time_point& rx_time) {
+    alignas(struct cmsghdr) char control[64];
+
+    struct iovec iov{};
+    iov.iov_base = &packet;
+    iov.iov_len = sizeof(packet);
+
+    struct msghdr msg{};
+    msg.msg_name = &src_addr;
+    msg.msg_namelen = sizeof(src_addr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received = recvmsg(fd, &msg, flags);
+    rx_time = std::chrono::steady_clock::now();
+    if (received < 0) {
+        return received;
+    }
+
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMP &&
+            cmsg->cmsg_len >= CMSG_LEN(sizeof(struct timeval))) {
+            struct timeval stamp;
+            std::memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+
+            struct timeval now_tv;
+            gettimeofday(&now_tv, nullptr);
+            auto queued = std::chrono::seconds(now_tv.tv_sec - stamp.tv_sec) +
+                          std::chrono::microseconds(now_tv.tv_usec - stamp.tv_usec);
+            if (queued > std::chrono::microseconds::zero()) {
+                rx_time -= queued;
+            }
+            break;
+        }
+    }
+    return received;
+}
+
 GenlockClock::GenlockClock(
     GenlockMode mode,
     const std::string& master_address,
@@ -74,7 +161,14 @@ bool GenlockClock::initialize() {
     if (setsockopt(socket_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
         LOG_DEBUG("Failed to set SO_REUSEADDR: %s", strerror(errno));
     }
-    
+
+    // Kernel receive timestamps for the offset math (both directions use them)
+    int timestamp = 1;
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMP, &timestamp, sizeof(timestamp)) < 0) {
+        LOG_WARNING("Failed to enable SO_TIMESTAMP, falling back to userspace stamps: %s",
+                    strerror(errno));
+    }
+
     if (mode_ == GenlockMode::Master) {
         // Master: bind to port for sending (OS will assign ephemeral port)
         struct sockaddr_in addr{};
@@ -102,29 +196,42 @@ bool GenlockClock::initialize() {
         
     } else {
         // Slave: bind to port for receiving
-        size_t colon_pos = master_address_.find(':');
+        std::string master_ip;
         int port = 5960;  // Default port
-        if (colon_pos != std::string::npos) {
-            port = std::stoi(master_address_.substr(colon_pos + 1));
-        }
-        
+        parse_address(master_address_, master_ip, port);
+
         LOG_INFO("Genlock slave attempting to bind to port %d", port);
-        
+
         struct sockaddr_in addr{};
         addr.sin_family = AF_INET;
         addr.sin_addr.s_addr = INADDR_ANY;
         addr.sin_port = htons(port);
-        
+
         if (bind(socket_fd_, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
             LOG_ERROR("Failed to bind genlock slave socket to port %d: %s", port, strerror(errno));
             close(socket_fd_);
             socket_fd_ = -1;
             return false;
         }
-        
-        LOG_INFO("Genlock slave successfully bound to port %d, waiting for master at %s", 
+
+        // Multicast group: join it so the master's per-frame beacon reaches us
+        if (is_multicast_address(master_ip)) {
+            struct ip_mreq mreq{};
+            inet_pton(AF_INET, master_ip.c_str(), &mreq.imr_multiaddr);
+            mreq.imr_interface.s_addr = INADDR_ANY;
+            if (setsockopt(socket_fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+                LOG_ERROR("Failed to join multicast group %s: %s",
+                          master_ip.c_str(), strerror(errno));
+                close(socket_fd_);
+                socket_fd_ = -1;
+                return false;
+            }
+            LOG_INFO("Genlock slave joined multicast group %s", master_ip.c_str());
+        }
+
+        LOG_INFO("Genlock slave successfully bound to port %d, waiting for master at %s",
                  port, master_address_.c_str());
-        
+
         // Set receive timeout
         struct timeval tv{};
         tv.tv_sec = 0;
@@ -174,7 +281,13 @@ void GenlockClock::shutdown() {
     // Mark as uninitialized
     initialized_ = false;
     synchronized_ = false;
-    
+
+    // Forget stagger assignments; slaves re-request slots on reconnect
+    {
+        std::lock_guard<std::mutex> lock(slot_mutex_);
+        slot_keys_.clear();
+    }
+
     LOG_DEBUG("Genlock shutdown complete");
 }
 
@@ -205,13 +318,25 @@ std::chrono::steady_clock::time_point GenlockClock::next_frame_boundary(
     auto elapsed = current_time - reference_time_;
     auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
     
+    // The phase offset shifts this stream's send slot within the frame
+    // interval so co-hosted streams do not all hit the NIC in the same
+    // instant; fold it into [0, frame) and compute boundaries on the
+    // shifted timeline so consecutive slots stay one frame apart
+    const int64_t phase_ns =
+        ((phase_offset_ns_.load() % frame_duration.count()) +
+         frame_duration.count()) % frame_duration.count();
+    auto elapsed_since_phase = elapsed_ns - phase_ns;
+
     // Calculate current frame number
-    int64_t current_frame = elapsed_ns / frame_duration.count();
-    
-    // Next frame boundary
+    int64_t current_frame = elapsed_since_phase / frame_duration.count();
+    if (elapsed_since_phase < 0) {
+        current_frame--;  // Floor division for the first frame after start
+    }
+
+    // Next frame boundary (on the phase-shifted timeline)
     int64_t next_frame = current_frame + 1;
-    int64_t next_boundary_ns = next_frame * frame_duration.count();
-    
+    int64_t next_boundary_ns = next_frame * frame_duration.count() + phase_ns;
+
     return reference_time_ + std::chrono::nanoseconds(next_boundary_ns);
 }
 
@@ -221,14 +346,25 @@ int64_t GenlockClock::get_ndi_timecode() const {
         return INT64_C(0x7FFFFFFFFFFFFFFF);
     }
     
-    // Calculate timecode in 100ns units since reference
+    // Calculate timecode in 100ns units since reference. Subtract the
+    // phase offset so a staggered stream stamps the same timecode as an
+    // unstaggered one for the same frame - the stagger moves the network
+    // send, not the on-air alignment.
     auto current = now();
     auto elapsed = current - reference_time_;
-    auto elapsed_100ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / 100;
-    
+    auto elapsed_100ns = (std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() -
+                          phase_offset_ns_.load()) / 100;
+
     return elapsed_100ns;
 }
 
+void GenlockClock::set_phase_offset_us(int64_t offset_us) {
+    phase_explicit_ = true;
+    phase_offset_ns_ = offset_us * 1000;
+    LOG_INFO("Genlock phase offset pinned to %lld us",
+             static_cast<long long>(offset_us));
+}
+
 void GenlockClock::set_mode(GenlockMode mode) {
     if (mode == mode_) {
         return;
@@ -292,29 +428,35 @@ GenlockClock::Stats GenlockClock::get_stats() const {
 void GenlockClock::master_thread() {
     LOG_INFO("Genlock master thread started");
     
-    // Parse master address for broadcast
+    // Parse master address for broadcast/multicast
     std::string ip_addr = "127.0.0.1";
     int port = 5960;
-    
-    size_t colon_pos = master_address_.find(':');
-    if (colon_pos != std::string::npos) {
-        ip_addr = master_address_.substr(0, colon_pos);
-        port = std::stoi(master_address_.substr(colon_pos + 1));
-    }
-    
+    parse_address(master_address_, ip_addr, port);
+
     LOG_INFO("Genlock master will send sync packets to %s:%d", ip_addr.c_str(), port);
-    
+
     struct sockaddr_in dest_addr{};
     dest_addr.sin_family = AF_INET;
     dest_addr.sin_port = htons(port);
     inet_pton(AF_INET, ip_addr.c_str(), &dest_addr.sin_addr);
-    
+
     // Enable broadcast if using broadcast address
     if (ip_addr.find("255") != std::string::npos) {
         int broadcast = 1;
         setsockopt(socket_fd_, SOL_SOCKET, SO_BROADCAST, &broadcast, sizeof(broadcast));
     }
-    
+
+    // Multicast group: one beacon per frame serves every listener. Keep
+    // loopback on so slaves on this host still hear it, and TTL at 1 so
+    // beacons stay rack-local.
+    if (is_multicast_address(ip_addr)) {
+        unsigned char loop = 1;
+        setsockopt(socket_fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+        unsigned char ttl = 1;
+        setsockopt(socket_fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+        LOG_INFO("Genlock master using multicast distribution");
+    }
+
     int64_t frame_number = 0;
     auto frame_duration = std::chrono::nanoseconds(1'000'000'000 / fps_);
     auto next_send = std::chrono::steady_clock::now();
@@ -329,20 +471,21 @@ void GenlockClock::master_thread() {
         // Prepare sync packet
         GenlockPacket packet;
         auto timestamp = std::chrono::steady_clock::now() - reference_time_;
+        packet.type = kPacketSync;
         packet.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp).count();
         packet.frame_number = frame_number;
         packet.fps = fps_;
         packet.checksum = packet.calculate_checksum();
-        
+
         // Send packet
         ssize_t sent = sendto(socket_fd_, &packet, sizeof(packet), 0,
                              (struct sockaddr*)&dest_addr, sizeof(dest_addr));
-        
+
         if (sent == sizeof(packet)) {
             packets_sent_++;
             // Log first few packets for debugging
             if (packets_sent_ <= 3 || packets_sent_ % 60 == 0) {
-                LOG_DEBUG("Genlock master sent packet #%llu (frame %lld)", 
+                LOG_DEBUG("Genlock master sent packet #%llu (frame %lld)",
                          packets_sent_.load(), packet.frame_number);
             }
         } else if (sent < 0) {
@@ -350,7 +493,54 @@ void GenlockClock::master_thread() {
         } else {
             LOG_WARNING("Partial send: sent %zd bytes, expected %zu", sent, sizeof(packet));
         }
-        
+
+        // Answer any delay requests that arrived since the last tick. The
+        // kernel timestamp carries the true arrival time, so answering them
+        // once per frame does not hurt the slave's offset math.
+        GenlockPacket request;
+        struct sockaddr_in req_addr{};
+        std::chrono::steady_clock::time_point rx_time;
+        while (recv_with_timestamp(socket_fd_, request, req_addr, MSG_DONTWAIT, rx_time) ==
+               static_cast<ssize_t>(sizeof(request))) {
+            if (!request.validate() || request.type != kPacketDelayRequest) {
+                continue;
+            }
+
+            GenlockPacket response;
+            response.type = kPacketDelayResponse;
+            response.fps = fps_;
+            response.timestamp_ns = request.timestamp_ns; // Echo slave send time
+            response.receive_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                rx_time - reference_time_).count();
+            response.frame_number = request.frame_number;
+
+            // Automatic stagger: hand each slave endpoint a stable slot in
+            // first-contact order (the master keeps slot 0), and the total
+            // count, so slaves spread their send slots across the frame
+            {
+                const uint64_t key =
+                    (static_cast<uint64_t>(ntohl(req_addr.sin_addr.s_addr)) << 16) |
+                    ntohs(req_addr.sin_port);
+                std::lock_guard<std::mutex> lock(slot_mutex_);
+                auto it = std::find(slot_keys_.begin(), slot_keys_.end(), key);
+                if (it == slot_keys_.end()) {
+                    slot_keys_.push_back(key);
+                    it = std::prev(slot_keys_.end());
+                    LOG_INFO("Genlock master assigned stagger slot %zu of %zu",
+                             slot_keys_.size(), slot_keys_.size() + 1);
+                }
+                response.phase_slot =
+                    static_cast<uint32_t>(it - slot_keys_.begin()) + 1;
+                response.phase_slot_count =
+                    static_cast<uint32_t>(slot_keys_.size()) + 1;
+            }
+
+            response.checksum = response.calculate_checksum();
+
+            sendto(socket_fd_, &response, sizeof(response), 0,
+                   (struct sockaddr*)&req_addr, sizeof(req_addr));
+        }
+
         // Schedule next send
         frame_number++;
         next_send += frame_duration;
@@ -361,68 +551,154 @@ void GenlockClock::master_thread() {
 
 void GenlockClock::slave_thread() {
     LOG_INFO("Genlock slave thread started, waiting for sync packets...");
-    
+
     GenlockPacket packet;
     struct sockaddr_in src_addr{};
-    socklen_t src_len = sizeof(src_addr);
-    
+
     std::vector<int64_t> offset_history;
     offset_history.reserve(100);
-    
+
+    // Path delays of recent completed exchanges, for outlier rejection
+    std::vector<int64_t> delay_history;
+    delay_history.reserve(32);
+
+    // Sync times awaiting the matching delay response (one in flight)
+    int64_t pending_t1_ns = 0;
+    int64_t pending_t2_ns = 0;
+    bool exchange_pending = false;
+
+    // Multicast slaves listen passively: a delay exchange from N slaves
+    // would turn the master back into a per-slave hot spot
+    std::string master_ip;
+    int master_port = 5960;
+    parse_address(master_address_, master_ip, master_port);
+    const bool passive = is_multicast_address(master_ip);
+
+    // Fold an accepted offset sample into the sync state and jitter stats
+    auto accept_offset = [&](int64_t offset_us) {
+        update_sync_offset(offset_us);
+
+        // Track offset history for jitter calculation
+        offset_history.push_back(offset_us);
+        if (offset_history.size() > 100) {
+            offset_history.erase(offset_history.begin());
+        }
+
+        // Calculate jitter
+        if (offset_history.size() > 1) {
+            int64_t sum = 0;
+            for (auto o : offset_history) sum += o;
+            int64_t avg = sum / offset_history.size();
+
+            int64_t variance_sum = 0;
+            for (auto o : offset_history) {
+                int64_t diff = o - avg;
+                variance_sum += diff * diff;
+            }
+            double variance = static_cast<double>(variance_sum) / offset_history.size();
+            jitter_us_ = std::sqrt(variance);
+        }
+
+        synchronized_ = true;
+    };
+
     int timeout_count = 0;
-    
+
     while (running_) {
-        // Receive sync packet
-        ssize_t received = recvfrom(socket_fd_, &packet, sizeof(packet), 0,
-                                   (struct sockaddr*)&src_addr, &src_len);
-        
-        if (received == sizeof(packet) && packet.validate()) {
+        // Receive packet with its kernel arrival timestamp
+        std::chrono::steady_clock::time_point rx_time;
+        ssize_t received = recv_with_timestamp(socket_fd_, packet, src_addr, 0, rx_time);
+
+        if (received == static_cast<ssize_t>(sizeof(packet)) && packet.validate() &&
+            packet.type == kPacketSync) {
             packets_received_++;
-            
+
             // Log first few packets
             if (packets_received_ == 1) {
                 char src_ip[INET_ADDRSTRLEN];
                 inet_ntop(AF_INET, &src_addr.sin_addr, src_ip, sizeof(src_ip));
-                LOG_INFO("Genlock slave received first sync packet from %s:%d", 
+                LOG_INFO("Genlock slave received first sync packet from %s:%d",
                          src_ip, ntohs(src_addr.sin_port));
             } else if (packets_received_ <= 5 || packets_received_ % 60 == 0) {
                 LOG_DEBUG("Genlock slave received packet #%llu", packets_received_.load());
             }
-            
+
             timeout_count = 0;
-            
-            // Calculate time offset
-            auto local_now = std::chrono::steady_clock::now();
-            auto master_time = reference_time_ + std::chrono::nanoseconds(packet.timestamp_ns);
-            auto offset = std::chrono::duration_cast<std::chrono::microseconds>(
-                local_now - master_time).count();
-            
-            // Update sync state
-            update_sync_offset(offset);
-            
-            // Track offset history for jitter calculation
-            offset_history.push_back(offset);
-            if (offset_history.size() > 100) {
-                offset_history.erase(offset_history.begin());
+
+            // t1: master send time, t2: our kernel arrival time
+            pending_t1_ns = packet.timestamp_ns;
+            pending_t2_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                rx_time - reference_time_).count();
+
+            if (passive) {
+                // Multicast beacon: one-way offset straight from the kernel
+                // arrival stamp, no reply traffic towards the master
+                accept_offset((pending_t2_ns - pending_t1_ns) / 1000);
+            } else {
+                exchange_pending = true;
+
+                // Complete the exchange: ask the master when it sees our request
+                GenlockPacket request;
+                request.type = kPacketDelayRequest;
+                request.fps = packet.fps;
+                request.frame_number = packet.frame_number;
+                request.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - reference_time_).count();
+                request.checksum = request.calculate_checksum();
+
+                sendto(socket_fd_, &request, sizeof(request), 0,
+                       (struct sockaddr*)&src_addr, sizeof(src_addr));
+            }
+
+        } else if (received == static_cast<ssize_t>(sizeof(packet)) && packet.validate() &&
+                   packet.type == kPacketDelayResponse && exchange_pending) {
+            exchange_pending = false;
+
+            // PTP-style two-way math: t1/t2 from the sync leg, t3 (echoed
+            // request send time) / t4 (master kernel rx time) from this leg
+            const int64_t t1 = pending_t1_ns;
+            const int64_t t2 = pending_t2_ns;
+            const int64_t t3 = packet.timestamp_ns;
+            const int64_t t4 = packet.receive_ns;
+
+            const int64_t offset_ns = ((t2 - t1) - (t4 - t3)) / 2;
+            const int64_t delay_ns = ((t2 - t1) + (t4 - t3)) / 2;
+
+            if (delay_ns < 0) {
+                sync_failures_++;
+                continue; // Nonsensical exchange (reordered packets)
+            }
+
+            // Outlier rejection: a queued or retransmitted exchange shows up
+            // as inflated path delay, and its offset is not trustworthy
+            delay_history.push_back(delay_ns);
+            if (delay_history.size() > 32) {
+                delay_history.erase(delay_history.begin());
             }
-            
-            // Calculate jitter
-            if (offset_history.size() > 1) {
-                int64_t sum = 0;
-                for (auto o : offset_history) sum += o;
-                int64_t avg = sum / offset_history.size();
-                
-                int64_t variance_sum = 0;
-                for (auto o : offset_history) {
-                    int64_t diff = o - avg;
-                    variance_sum += diff * diff;
+            const int64_t min_delay = *std::min_element(delay_history.begin(),
+                                                        delay_history.end());
+            const int64_t threshold = min_delay + std::max<int64_t>(min_delay / 2, 50'000);
+            if (delay_ns > threshold && delay_history.size() >= 8) {
+                continue; // Keep the sample's delay for the window, skip its offset
+            }
+
+            accept_offset(offset_ns / 1000);
+
+            // Apply the master's stagger assignment: slot N of M spreads
+            // this stream's send slot N/M of a frame after the boundary.
+            // An operator-pinned offset always wins.
+            if (!phase_explicit_.load() && packet.phase_slot_count > 1) {
+                const int64_t frame_ns = 1'000'000'000LL / fps_;
+                const int64_t stagger_ns =
+                    frame_ns * packet.phase_slot / packet.phase_slot_count;
+                if (stagger_ns != phase_offset_ns_.load()) {
+                    phase_offset_ns_ = stagger_ns;
+                    LOG_INFO("Genlock stagger: slot %u of %u, send slot offset %lld us",
+                             packet.phase_slot, packet.phase_slot_count,
+                             static_cast<long long>(stagger_ns / 1000));
                 }
-                double variance = static_cast<double>(variance_sum) / offset_history.size();
-                jitter_us_ = std::sqrt(variance);
             }
-            
-            synchronized_ = true;
-            
+
         } else if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
             LOG_ERROR("Failed to receive genlock packet: %s (errno=%d)", strerror(errno), errno);
             sync_failures_++;
@@ -431,18 +707,18 @@ void GenlockClock::slave_thread() {
         } else if (received > 0 && !packet.validate()) {
             LOG_WARNING("Received invalid packet (bad magic or checksum)");
         }
-        
+
         // Check for sync timeout and log periodically
         if (!synchronized_ && packets_received_ == 0) {
             timeout_count++;
             if (timeout_count == 1 || timeout_count % 100 == 0) {
-                LOG_WARNING("Genlock slave waiting for sync packets... (no packets received yet, count=%d)", 
+                LOG_WARNING("Genlock slave waiting for sync packets... (no packets received yet, count=%d)",
                            timeout_count);
             }
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
     }
-    
+
     LOG_INFO("Genlock slave thread exited. Received %llu packets total", packets_received_.load());
 }
 
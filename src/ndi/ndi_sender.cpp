@@ -3,7 +3,9 @@
  */
 
 #include "html2ndi/ndi/ndi_sender.h"
+#include "html2ndi/ndi/pixel_convert.h"
 #include "html2ndi/utils/logger.h"
+#include "html2ndi/utils/watchdog.h"
 
 #include <cstring>
 #include <sstream>
@@ -52,7 +54,16 @@ bool NdiSender::initialize() {
     
     initialized_ = true;
     LOG_INFO("NDI sender created: %s", name_.c_str());
-    
+
+    // Background event thread: one place pays the SDK query cost, every
+    // per-frame/per-tick consumer reads cached atomics. Seed the cache
+    // before the first poll so the frame path sees a sane state at once.
+    const int connections = NDIlib_send_get_no_connections(sender_, 0);
+    connection_count_ = connections;
+    connected_ = connections > 0;
+    event_running_ = true;
+    event_thread_handle_ = std::thread(&NdiSender::event_thread, this);
+
     return true;
 }
 
@@ -62,8 +73,21 @@ void NdiSender::shutdown() {
     }
     
     LOG_DEBUG("Shutting down NDI sender...");
-    
+
+    // Stop the event thread before the sender instance it polls
+    if (event_running_.exchange(false) && event_thread_handle_.joinable()) {
+        event_thread_handle_.join();
+    }
+
     if (sender_) {
+        // Flush any in-flight async frame so the SDK releases our buffer
+        // before the sender is destroyed
+        if (async_in_flight_) {
+            std::lock_guard<std::mutex> lock(send_mutex_);
+            NDIlib_send_send_video_async_v2(sender_, nullptr);
+            async_in_flight_ = false;
+        }
+
         NDIlib_send_destroy(sender_);
         sender_ = nullptr;
     }
@@ -80,37 +104,199 @@ void NdiSender::send_video_frame(
     int height,
     int frame_rate_n,
     int frame_rate_d,
-    bool progressive) {
-    
+    bool progressive,
+    int64_t capture_timestamp) {
+
+    send_video_internal(data, width, height, height,
+                        frame_rate_n, frame_rate_d,
+                        progressive ? NDIlib_frame_format_type_progressive
+                                    : NDIlib_frame_format_type_interleaved,
+                        capture_timestamp);
+}
+
+void NdiSender::send_video_field(
+    const uint8_t* data,
+    int width,
+    int field_height,
+    int frame_rate_n,
+    int frame_rate_d,
+    bool top_field,
+    int64_t capture_timestamp) {
+
+    send_video_internal(data, width, field_height, field_height * 2,
+                        frame_rate_n, frame_rate_d,
+                        top_field ? NDIlib_frame_format_type_field_0
+                                  : NDIlib_frame_format_type_field_1,
+                        capture_timestamp);
+}
+
+void NdiSender::send_video_internal(
+    const uint8_t* data,
+    int width,
+    int height,
+    int display_height,
+    int frame_rate_n,
+    int frame_rate_d,
+    NDIlib_frame_format_type_e frame_format,
+    int64_t capture_timestamp) {
+
     if (!initialized_ || !sender_) {
         return;
     }
-    
+
     std::lock_guard<std::mutex> lock(send_mutex_);
-    
+
     // Setup video frame
     video_frame_.xres = width;
     video_frame_.yres = height;
-    video_frame_.FourCC = NDIlib_FourCC_video_type_BGRX;
     video_frame_.frame_rate_N = frame_rate_n;
     video_frame_.frame_rate_D = frame_rate_d;
-    video_frame_.picture_aspect_ratio = static_cast<float>(width) / static_cast<float>(height);
-    video_frame_.frame_format_type = progressive 
-        ? NDIlib_frame_format_type_progressive 
-        : NDIlib_frame_format_type_interleaved;
+    video_frame_.picture_aspect_ratio = static_cast<float>(width) / static_cast<float>(display_height);
+    video_frame_.frame_format_type = frame_format;
 
 
 
     video_frame_.timecode = next_timecode_.load();  // Use configured timecode
-    video_frame_.p_data = const_cast<uint8_t*>(data);
-    video_frame_.line_stride_in_bytes = width * 4;
-    video_frame_.timestamp = 0;
-    
+    // Stamp the frame with its capture time so receivers measure pipeline
+    // age instead of send time (0 = let the SDK fill in the send time)
+    video_frame_.timestamp = capture_timestamp;
+
     // Set color space metadata
     video_frame_.p_metadata = color_metadata_.c_str();
-    
+
+    const PixelFormat format = pixel_format_.load();
+
+    // Limited range is a real pixel transform, not just metadata: RGB
+    // formats get the 0-255 -> 16-235 compression here, fused into the
+    // outgoing copy so the frame is touched once. The UYVY path already
+    // applies the range through its conversion coefficients.
+    const bool limited = (color_range_ == ColorRange::Limited);
+
+    if (format == PixelFormat::UYVY) {
+        // Convert BGRA to UYVY on our side: 2 bytes/pixel on the wire and
+        // the SDK skips its own internal colorspace conversion
+        size_t size = static_cast<size_t>(width) * height * 2;
+        uint8_t* dst;
+        if (async_send_) {
+            auto& buffer = async_buffers_[async_buffer_index_];
+            async_buffer_index_ = (async_buffer_index_ + 1) % kAsyncBufferCount;
+            if (buffer.size() != size) {
+                buffer.resize(size);
+            }
+            dst = buffer.data();
+        } else {
+            if (video_buffer_.size() != size) {
+                video_buffer_.resize(size);
+            }
+            dst = video_buffer_.data();
+        }
+
+        bgra_to_uyvy(data, width, height, color_space_, color_range_, dst);
+
+        video_frame_.FourCC = NDIlib_FourCC_video_type_UYVY;
+        video_frame_.line_stride_in_bytes = width * 2;
+        video_frame_.p_data = dst;
+
+        if (async_send_) {
+            NDIlib_send_send_video_async_v2(sender_, &video_frame_);
+            async_in_flight_ = true;
+        } else {
+            NDIlib_send_send_video_v2(sender_, &video_frame_);
+        }
+        return;
+    }
+
+    if (format == PixelFormat::BGRA) {
+        // Carry the alpha channel to receivers. CEF renders premultiplied,
+        // so Premultiplied mode is a plain copy; Straight mode runs the
+        // unpremultiply kernel into the outgoing buffer.
+        const bool straight = (alpha_mode_.load() == AlphaMode::Straight);
+        size_t size = static_cast<size_t>(width) * height * 4;
+
+        video_frame_.FourCC = NDIlib_FourCC_video_type_BGRA;
+        video_frame_.line_stride_in_bytes = width * 4;
+
+        uint8_t* dst = nullptr;
+        if (async_send_) {
+            auto& buffer = async_buffers_[async_buffer_index_];
+            async_buffer_index_ = (async_buffer_index_ + 1) % kAsyncBufferCount;
+            if (buffer.size() != size) {
+                buffer.resize(size);
+            }
+            dst = buffer.data();
+        } else if (straight || limited) {
+            if (video_buffer_.size() != size) {
+                video_buffer_.resize(size);
+            }
+            dst = video_buffer_.data();
+        }
+
+        if (dst) {
+            if (straight) {
+                bgra_unpremultiply(data, width, height, dst);
+                if (limited) {
+                    bgra_full_to_limited(dst, width, height, dst);
+                }
+            } else if (limited) {
+                // Range compression replaces the copy: one pass
+                bgra_full_to_limited(data, width, height, dst);
+            } else {
+                std::memcpy(dst, data, size);
+            }
+            video_frame_.p_data = dst;
+        } else {
+            // Sync premultiplied full-range send: the SDK is done with the
+            // frame when the call returns, so the caller's buffer can go
+            // out directly
+            video_frame_.p_data = const_cast<uint8_t*>(data);
+        }
+
+        if (async_send_) {
+            NDIlib_send_send_video_async_v2(sender_, &video_frame_);
+            async_in_flight_ = true;
+        } else {
+            NDIlib_send_send_video_v2(sender_, &video_frame_);
+        }
+        return;
+    }
+
+    video_frame_.FourCC = NDIlib_FourCC_video_type_BGRX;
+    video_frame_.line_stride_in_bytes = width * 4;
+
     // Send frame
-    NDIlib_send_send_video_v2(sender_, &video_frame_);
+    if (async_send_) {
+        // Copy into an owned buffer and hand it off to the SDK. The copy is
+        // cheap compared to the compress/transmit the sync path blocks on;
+        // in limited range the range kernel takes the copy's place.
+        size_t size = static_cast<size_t>(width) * height * 4;
+        auto& buffer = async_buffers_[async_buffer_index_];
+        async_buffer_index_ = (async_buffer_index_ + 1) % kAsyncBufferCount;
+
+        if (buffer.size() != size) {
+            buffer.resize(size);
+        }
+        if (limited) {
+            bgra_full_to_limited(data, width, height, buffer.data());
+        } else {
+            std::memcpy(buffer.data(), data, size);
+        }
+
+        video_frame_.p_data = buffer.data();
+        NDIlib_send_send_video_async_v2(sender_, &video_frame_);
+        async_in_flight_ = true;
+    } else if (limited) {
+        // Sync limited-range send needs an owned buffer for the transform
+        size_t size = static_cast<size_t>(width) * height * 4;
+        if (video_buffer_.size() != size) {
+            video_buffer_.resize(size);
+        }
+        bgra_full_to_limited(data, width, height, video_buffer_.data());
+        video_frame_.p_data = video_buffer_.data();
+        NDIlib_send_send_video_v2(sender_, &video_frame_);
+    } else {
+        video_frame_.p_data = const_cast<uint8_t*>(data);
+        NDIlib_send_send_video_v2(sender_, &video_frame_);
+    }
 }
 
 void NdiSender::send_audio_frame(
@@ -143,26 +329,74 @@ int NdiSender::get_connection_count(uint32_t timeout_ms) const {
     if (!initialized_ || !sender_) {
         return 0;
     }
-    
+
+    // The event thread keeps this fresh; only an explicit wait needs the SDK
+    if (timeout_ms == 0 && event_running_.load()) {
+        return connection_count_.load(std::memory_order_relaxed);
+    }
+
     return NDIlib_send_get_no_connections(sender_, timeout_ms);
 }
 
 NdiSender::TallyState NdiSender::get_tally(uint32_t timeout_ms) const {
     TallyState state;
-    
+
     if (!initialized_ || !sender_) {
         return state;
     }
-    
+
+    if (timeout_ms == 0 && event_running_.load()) {
+        state.on_program = tally_program_.load(std::memory_order_relaxed);
+        state.on_preview = tally_preview_.load(std::memory_order_relaxed);
+        return state;
+    }
+
     NDIlib_tally_t ndi_tally;
     if (NDIlib_send_get_tally(sender_, &ndi_tally, timeout_ms)) {
         state.on_program = ndi_tally.on_program;
         state.on_preview = ndi_tally.on_preview;
     }
-    
+
     return state;
 }
 
+void NdiSender::event_thread() {
+    Watchdog::register_current_thread("ndi-events");
+
+    while (event_running_) {
+        // Drain receiver metadata; the 100 ms capture timeout doubles as
+        // the loop's poll interval
+        NDIlib_metadata_frame_t metadata{};
+        if (NDIlib_send_capture(sender_, &metadata, 100) ==
+            NDIlib_frame_type_metadata) {
+            metadata_received_++;
+            NDIlib_send_free_metadata(sender_, &metadata);
+        }
+
+        const int connections = NDIlib_send_get_no_connections(sender_, 0);
+        connection_count_.store(connections, std::memory_order_relaxed);
+
+        const bool now_connected = connections > 0;
+        if (now_connected != connected_.load(std::memory_order_relaxed)) {
+            connected_.store(now_connected, std::memory_order_relaxed);
+            if (now_connected) {
+                LOG_INFO("Receiver connected (%d): resuming transmission",
+                         connections);
+            } else {
+                LOG_INFO("Last receiver disconnected: suspending transmission");
+            }
+        }
+
+        NDIlib_tally_t ndi_tally;
+        if (NDIlib_send_get_tally(sender_, &ndi_tally, 0)) {
+            tally_program_.store(ndi_tally.on_program, std::memory_order_relaxed);
+            tally_preview_.store(ndi_tally.on_preview, std::memory_order_relaxed);
+        }
+    }
+
+    Watchdog::unregister_current_thread();
+}
+
 std::string NdiSender::get_source_name() const {
     if (!initialized_ || !sender_) {
         return name_;
@@ -215,5 +449,22 @@ std::string NdiSender::color_range_name() const {
     return "full";
 }
 
+std::string NdiSender::pixel_format_name() const {
+    switch (pixel_format_.load()) {
+        case PixelFormat::BGRX: return "bgra";
+        case PixelFormat::UYVY: return "uyvy";
+        case PixelFormat::BGRA: return "alpha";
+    }
+    return "bgra";
+}
+
+std::string NdiSender::alpha_mode_name() const {
+    switch (alpha_mode_.load()) {
+        case AlphaMode::Premultiplied: return "premultiplied";
+        case AlphaMode::Straight:      return "straight";
+    }
+    return "premultiplied";
+}
+
 } // namespace html2ndi
 
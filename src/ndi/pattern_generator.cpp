@@ -0,0 +1,301 @@
+/**
+ * Procedural test-pattern generator implementation.
+ *
+ * The dynamic bands are NEON-vectorized on arm64 with a scalar fallback:
+ * the zone plate is computed as one grayscale row then expanded to BGRA
+ * 16 pixels at a time, and the static color bars are memcpy'd from a
+ * prerendered template row.
+ */
+
+#include "html2ndi/ndi/pattern_generator.h"
+#include "html2ndi/utils/logger.h"
+#include "html2ndi/utils/watchdog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define HTML2NDI_HAVE_NEON 1
+#endif
+
+namespace html2ndi {
+
+namespace {
+
+// 75% color bars, left to right: white, yellow, cyan, green, magenta,
+// red, blue, black (BGRA byte order)
+constexpr uint8_t kBars[8][4] = {
+    {191, 191, 191, 255}, {0, 191, 191, 255}, {191, 191, 0, 255},
+    {0, 191, 0, 255},     {191, 0, 191, 255}, {0, 0, 191, 255},
+    {191, 0, 0, 255},     {0, 0, 0, 255},
+};
+
+// Triangle wave on the low 9 bits: 0..255..0, used as the zone plate
+// intensity function (cheap integer stand-in for cos)
+inline uint8_t triangle_wave(uint32_t v) {
+    uint32_t t = v & 511;
+    return static_cast<uint8_t>(t < 256 ? t : 511 - t);
+}
+
+// 3x5 bitmap digits for the frame-counter burn-in, row-major, MSB left
+constexpr uint16_t kDigitFont[10] = {
+    0b111101101101111,  // 0
+    0b010110010010111,  // 1
+    0b111001111100111,  // 2
+    0b111001111001111,  // 3
+    0b101101111001001,  // 4
+    0b111100111001111,  // 5
+    0b111100111101111,  // 6
+    0b111001001001001,  // 7
+    0b111101111101111,  // 8
+    0b111101111001111,  // 9
+};
+
+/**
+ * Expand a grayscale row to opaque BGRA. NEON path writes 16 pixels per
+ * iteration with a four-plane interleaved store.
+ */
+void expand_gray_row_scalar(const uint8_t* gray, uint8_t* dst, int width) {
+    for (int x = 0; x < width; x++) {
+        uint8_t g = gray[x];
+        dst[x * 4 + 0] = g;
+        dst[x * 4 + 1] = g;
+        dst[x * 4 + 2] = g;
+        dst[x * 4 + 3] = 255;
+    }
+}
+
+#ifdef HTML2NDI_HAVE_NEON
+void expand_gray_row_neon(const uint8_t* gray, uint8_t* dst, int width) {
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        uint8x16_t g = vld1q_u8(gray + x);
+        uint8x16x4_t bgra;
+        bgra.val[0] = g;
+        bgra.val[1] = g;
+        bgra.val[2] = g;
+        bgra.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst + x * 4, bgra);
+    }
+    if (x < width) {
+        expand_gray_row_scalar(gray + x, dst + x * 4, width - x);
+    }
+}
+#endif
+
+void expand_gray_row(const uint8_t* gray, uint8_t* dst, int width) {
+#ifdef HTML2NDI_HAVE_NEON
+    expand_gray_row_neon(gray, dst, width);
+#else
+    expand_gray_row_scalar(gray, dst, width);
+#endif
+}
+
+} // namespace
+
+PatternGenerator::PatternGenerator(int width, int height, int fps_n, int fps_d,
+                                   SubmitCallback submit)
+    : width_(width)
+    , height_(height)
+    , fps_n_(fps_n)
+    , fps_d_(fps_d)
+    , submit_(std::move(submit))
+    , frame_(static_cast<size_t>(width) * height * 4)
+    , x_squared_(width)
+    , gray_row_(width) {
+    // Band layout: bars on the top 60%, zone plate below, counter strip
+    // on the bottom 32 rows (or whatever remains on tiny frames)
+    bars_bottom_ = height_ * 3 / 5;
+    plate_bottom_ = std::max(bars_bottom_, height_ - 32);
+
+    for (int x = 0; x < width_; x++) {
+        x_squared_[x] = static_cast<uint32_t>(x) * static_cast<uint32_t>(x);
+    }
+
+    render_bars();
+}
+
+PatternGenerator::~PatternGenerator() {
+    stop();
+}
+
+void PatternGenerator::start() {
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    thread_ = std::thread(&PatternGenerator::generator_thread, this);
+    LOG_INFO("Pattern generator started: %dx%d @ %d/%d fps",
+             width_, height_, fps_n_, fps_d_);
+}
+
+void PatternGenerator::stop() {
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    LOG_INFO("Pattern generator stopped (%llu frames generated)",
+             static_cast<unsigned long long>(frames_generated_.load()));
+}
+
+void PatternGenerator::generate_frame() {
+    auto start = std::chrono::steady_clock::now();
+
+    uint64_t frame = frames_generated_.load();
+    render_zone_plate(frame);
+    render_counter(frame);
+
+    FrameRectList dirty;
+    dirty.push_back({0, 0, width_, height_});
+    submit_(frame_.data(), width_, height_, dirty);
+
+    frames_generated_.fetch_add(1);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    avg_generate_time_us_ = 0.9 * avg_generate_time_us_.load() + 0.1 * elapsed;
+}
+
+void PatternGenerator::render_bars() {
+    if (bars_bottom_ <= 0 || width_ <= 0) {
+        return;
+    }
+
+    // Paint one template row, then replicate it
+    uint8_t* row0 = frame_.data();
+    for (int x = 0; x < width_; x++) {
+        int bar = x * 8 / width_;
+        std::memcpy(row0 + x * 4, kBars[bar], 4);
+    }
+    size_t row_bytes = static_cast<size_t>(width_) * 4;
+    for (int y = 1; y < bars_bottom_; y++) {
+        std::memcpy(frame_.data() + y * row_bytes, row0, row_bytes);
+    }
+}
+
+void PatternGenerator::render_zone_plate(uint64_t frame) {
+    size_t row_bytes = static_cast<size_t>(width_) * 4;
+    // Phase advances per frame so the rings sweep outward; the >>6 sets
+    // the ring pitch
+    uint32_t phase = static_cast<uint32_t>(frame) * 8;
+
+    for (int y = bars_bottom_; y < plate_bottom_; y++) {
+        uint32_t y_rel = static_cast<uint32_t>(y - bars_bottom_);
+        uint32_t y_squared = y_rel * y_rel;
+        for (int x = 0; x < width_; x++) {
+            gray_row_[x] = triangle_wave(((x_squared_[x] + y_squared) >> 6) + phase);
+        }
+        expand_gray_row(gray_row_.data(), frame_.data() + y * row_bytes, width_);
+    }
+}
+
+void PatternGenerator::render_counter(uint64_t frame) {
+    size_t row_bytes = static_cast<size_t>(width_) * 4;
+
+    // Black strip
+    for (int y = plate_bottom_; y < height_; y++) {
+        uint8_t* row = frame_.data() + y * row_bytes;
+        for (int x = 0; x < width_; x++) {
+            row[x * 4 + 0] = 0;
+            row[x * 4 + 1] = 0;
+            row[x * 4 + 2] = 0;
+            row[x * 4 + 3] = 255;
+        }
+    }
+
+    int strip_height = height_ - plate_bottom_;
+    if (strip_height < 7 || width_ < 40) {
+        return;
+    }
+
+    // Frame number as ten 3x5 digits at 4x scale, top-left of the strip.
+    // Rightmost pixel lands at 40*scale - 1, so the width caps the scale
+    // just like the strip height does.
+    int scale = std::min(4, strip_height / 7);
+    scale = std::min(scale, width_ / 40);
+    int digit_w = 4 * scale;  // 3 columns + 1 gap
+    uint64_t value = frame % 10000000000ULL;
+    for (int pos = 9; pos >= 0; pos--) {
+        uint16_t glyph = kDigitFont[value % 10];
+        value /= 10;
+        int origin_x = scale + pos * digit_w;
+        int origin_y = plate_bottom_ + scale;
+        for (int gy = 0; gy < 5; gy++) {
+            for (int gx = 0; gx < 3; gx++) {
+                if (!(glyph & (1 << (14 - gy * 3 - gx)))) {
+                    continue;
+                }
+                for (int sy = 0; sy < scale; sy++) {
+                    uint8_t* row = frame_.data() +
+                        (origin_y + gy * scale + sy) * row_bytes;
+                    for (int sx = 0; sx < scale; sx++) {
+                        int px = origin_x + gx * scale + sx;
+                        row[px * 4 + 0] = 255;
+                        row[px * 4 + 1] = 255;
+                        row[px * 4 + 2] = 255;
+                        row[px * 4 + 3] = 255;
+                    }
+                }
+            }
+        }
+    }
+
+    // Moving white block on the bottom rows: one pixel per frame, a
+    // simple motion/cadence check on the receive side
+    int block_y = height_ - std::max(2, scale * 2);
+    int block_x = static_cast<int>(frame % static_cast<uint64_t>(
+        std::max(1, width_ - 16)));
+    for (int y = block_y; y < height_; y++) {
+        uint8_t* row = frame_.data() + y * row_bytes;
+        for (int x = block_x; x < block_x + 16 && x < width_; x++) {
+            row[x * 4 + 0] = 255;
+            row[x * 4 + 1] = 255;
+            row[x * 4 + 2] = 255;
+        }
+    }
+}
+
+void PatternGenerator::generator_thread() {
+    LOG_DEBUG("Pattern generator thread started");
+    Watchdog::register_current_thread("pattern");
+
+    // Absolute integer schedule, same scheme as the frame pump: frame N
+    // is due at epoch + N * den / num seconds so fractional rates stay
+    // exact over time
+    auto schedule_epoch = std::chrono::steady_clock::now();
+    uint64_t frame_number = 0;
+
+    while (running_) {
+        generate_frame();
+
+        frame_number++;
+        while (frame_number >= static_cast<uint64_t>(fps_n_)) {
+            schedule_epoch += std::chrono::seconds(fps_d_);
+            frame_number -= fps_n_;
+        }
+        auto next_frame_time = schedule_epoch + std::chrono::nanoseconds(
+            static_cast<int64_t>(frame_number) * 1'000'000'000LL * fps_d_ / fps_n_);
+
+        // Rebase after a stall instead of bursting to catch up
+        auto frame_duration = std::chrono::nanoseconds(
+            1'000'000'000LL * fps_d_ / fps_n_);
+        if (std::chrono::steady_clock::now() - next_frame_time >
+                4 * frame_duration) {
+            schedule_epoch = std::chrono::steady_clock::now();
+            frame_number = 0;
+            next_frame_time = schedule_epoch;
+        }
+
+        std::this_thread::sleep_until(next_frame_time);
+    }
+
+    Watchdog::unregister_current_thread();
+    LOG_DEBUG("Pattern generator thread stopped");
+}
+
+} // namespace html2ndi
@@ -0,0 +1,363 @@
+/**
+ * Pixel format conversion kernels.
+ * NEON-vectorized on arm64 with scalar fallbacks.
+ */
+
+#include "html2ndi/ndi/pixel_convert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define HTML2NDI_HAVE_NEON 1
+#endif
+
+namespace html2ndi {
+
+UyvyCoefficients uyvy_coefficients(ColorSpace color_space, ColorRange color_range) {
+    double kr, kb;
+    switch (color_space) {
+        case ColorSpace::Rec2020: kr = 0.2627; kb = 0.0593; break;
+        case ColorSpace::Rec601:  kr = 0.2990; kb = 0.1140; break;
+        case ColorSpace::Rec709:
+        case ColorSpace::sRGB:  // Same primaries/matrix as BT.709
+        default:                  kr = 0.2126; kb = 0.0722; break;
+    }
+    const double kg = 1.0 - kr - kb;
+
+    const bool limited = (color_range == ColorRange::Limited);
+    const double y_scale = limited ? 219.0 / 255.0 : 1.0;
+    const double c_scale = limited ? 224.0 / 255.0 : 1.0;
+
+    UyvyCoefficients c;
+    c.yr = static_cast<uint8_t>(std::lround(256.0 * y_scale * kr));
+    c.yb = static_cast<uint8_t>(std::lround(256.0 * y_scale * kb));
+    // Assign the rounding residual to green so white maps exactly to peak Y
+    c.yg = static_cast<uint8_t>(std::lround(256.0 * y_scale) - c.yr - c.yb);
+    c.y_offset = limited ? 16 : 0;
+
+    const double du = 2.0 * (1.0 - kb);
+    const double dv = 2.0 * (1.0 - kr);
+    c.ur = static_cast<int16_t>(std::lround(256.0 * c_scale * kr / du));
+    c.ug = static_cast<int16_t>(std::lround(256.0 * c_scale * kg / du));
+    c.ub = static_cast<int16_t>(std::lround(256.0 * c_scale * 0.5));
+    c.vr = static_cast<int16_t>(std::lround(256.0 * c_scale * 0.5));
+    c.vg = static_cast<int16_t>(std::lround(256.0 * c_scale * kg / dv));
+    c.vb = static_cast<int16_t>(std::lround(256.0 * c_scale * kb / dv));
+    return c;
+}
+
+namespace {
+
+inline uint8_t clamp_u8(int value) {
+    return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+// Convert one pixel pair to a UYVY quad
+inline void convert_pair_scalar(const uint8_t* p0, const uint8_t* p1,
+                                const UyvyCoefficients& c, uint8_t* out) {
+    const int b0 = p0[0], g0 = p0[1], r0 = p0[2];
+    const int b1 = p1[0], g1 = p1[1], r1 = p1[2];
+
+    const int y0 = ((c.yr * r0 + c.yg * g0 + c.yb * b0 + 128) >> 8) + c.y_offset;
+    const int y1 = ((c.yr * r1 + c.yg * g1 + c.yb * b1 + 128) >> 8) + c.y_offset;
+
+    // Chroma from the pair average (truncating shift to match the NEON path)
+    const int ra = (r0 + r1) >> 1;
+    const int ga = (g0 + g1) >> 1;
+    const int ba = (b0 + b1) >> 1;
+    const int u = ((c.ub * ba - c.ur * ra - c.ug * ga + 128) >> 8) + 128;
+    const int v = ((c.vr * ra - c.vg * ga - c.vb * ba + 128) >> 8) + 128;
+
+    out[0] = clamp_u8(u);
+    out[1] = clamp_u8(y0);
+    out[2] = clamp_u8(v);
+    out[3] = clamp_u8(y1);
+}
+
+#ifdef HTML2NDI_HAVE_NEON
+
+// Convert a run of pixels (multiple of 16) within one row
+void convert_row_neon(const uint8_t* src, uint8_t* dst, int pixels,
+                      const UyvyCoefficients& c) {
+    const uint8x8_t yr = vdup_n_u8(c.yr);
+    const uint8x8_t yg = vdup_n_u8(c.yg);
+    const uint8x8_t yb = vdup_n_u8(c.yb);
+    const uint16x8_t y_offset = vdupq_n_u16(static_cast<uint16_t>(c.y_offset));
+    const int16x8_t ur = vdupq_n_s16(c.ur);
+    const int16x8_t ug = vdupq_n_s16(c.ug);
+    const int16x8_t ub = vdupq_n_s16(c.ub);
+    const int16x8_t vr = vdupq_n_s16(c.vr);
+    const int16x8_t vg = vdupq_n_s16(c.vg);
+    const int16x8_t vb = vdupq_n_s16(c.vb);
+    const int16x8_t bias = vdupq_n_s16(128);
+
+    for (int x = 0; x < pixels; x += 16) {
+        const uint8x16x4_t px = vld4q_u8(src);
+        src += 64;
+        const uint8x16_t b = px.val[0];
+        const uint8x16_t g = px.val[1];
+        const uint8x16_t r = px.val[2];
+
+        // Luma for all 16 pixels
+        uint16x8_t y_lo = vmull_u8(vget_low_u8(r), yr);
+        y_lo = vmlal_u8(y_lo, vget_low_u8(g), yg);
+        y_lo = vmlal_u8(y_lo, vget_low_u8(b), yb);
+        uint16x8_t y_hi = vmull_u8(vget_high_u8(r), yr);
+        y_hi = vmlal_u8(y_hi, vget_high_u8(g), yg);
+        y_hi = vmlal_u8(y_hi, vget_high_u8(b), yb);
+        const uint8x8_t y8_lo = vqmovn_u16(vqaddq_u16(vrshrq_n_u16(y_lo, 8), y_offset));
+        const uint8x8_t y8_hi = vqmovn_u16(vqaddq_u16(vrshrq_n_u16(y_hi, 8), y_offset));
+
+        // Chroma from averaged horizontal pairs (8 samples)
+        const int16x8_t r2 = vreinterpretq_s16_u16(vshrq_n_u16(vpaddlq_u8(r), 1));
+        const int16x8_t g2 = vreinterpretq_s16_u16(vshrq_n_u16(vpaddlq_u8(g), 1));
+        const int16x8_t b2 = vreinterpretq_s16_u16(vshrq_n_u16(vpaddlq_u8(b), 1));
+
+        int16x8_t u = vmulq_s16(b2, ub);
+        u = vmlsq_s16(u, r2, ur);
+        u = vmlsq_s16(u, g2, ug);
+        int16x8_t v = vmulq_s16(r2, vr);
+        v = vmlsq_s16(v, g2, vg);
+        v = vmlsq_s16(v, b2, vb);
+        const uint8x8_t u8 = vqmovun_s16(vaddq_s16(vrshrq_n_s16(u, 8), bias));
+        const uint8x8_t v8 = vqmovun_s16(vaddq_s16(vrshrq_n_s16(v, 8), bias));
+
+        // Interleave as U Y0 V Y1, splitting luma into even/odd samples
+        const uint8x8x2_t y_split = vuzp_u8(y8_lo, y8_hi);
+        const uint8x8x4_t out = {{u8, y_split.val[0], v8, y_split.val[1]}};
+        vst4_u8(dst, out);
+        dst += 32;
+    }
+}
+
+#endif // HTML2NDI_HAVE_NEON
+
+} // anonymous namespace
+
+void bgra_to_uyvy(const uint8_t* bgra, int width, int height,
+                  ColorSpace color_space, ColorRange color_range,
+                  uint8_t* out_uyvy) {
+    const UyvyCoefficients c = uyvy_coefficients(color_space, color_range);
+
+    const size_t src_stride = static_cast<size_t>(width) * 4;
+    const size_t dst_stride = static_cast<size_t>(width) * 2;
+
+#ifdef HTML2NDI_HAVE_NEON
+    const int vector_pixels = width & ~15;
+#else
+    const int vector_pixels = 0;
+#endif
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* src = bgra + y * src_stride;
+        uint8_t* dst = out_uyvy + y * dst_stride;
+
+#ifdef HTML2NDI_HAVE_NEON
+        if (vector_pixels > 0) {
+            convert_row_neon(src, dst, vector_pixels, c);
+        }
+#endif
+
+        // Scalar tail (entire row when NEON is unavailable)
+        for (int x = vector_pixels; x + 1 < width; x += 2) {
+            convert_pair_scalar(src + x * 4, src + (x + 1) * 4, c, dst + x * 2);
+        }
+        if (width & 1) {
+            // Odd trailing pixel: emit a half quad using its own chroma
+            uint8_t quad[4];
+            convert_pair_scalar(src + (width - 1) * 4, src + (width - 1) * 4, c, quad);
+            dst[(width - 1) * 2 + 0] = quad[0];
+            dst[(width - 1) * 2 + 1] = quad[1];
+        }
+    }
+}
+
+namespace {
+
+// Exact round(c * a / 255): x = c*a + 128; result = (x + (x >> 8)) >> 8
+inline uint8_t mul_alpha_scalar(int c, int a) {
+    const int x = c * a + 128;
+    return static_cast<uint8_t>((x + (x >> 8)) >> 8);
+}
+
+#ifdef HTML2NDI_HAVE_NEON
+
+// Same rounding as mul_alpha_scalar across 8 lanes
+inline uint8x8_t mul_alpha_u16(uint16x8_t x) {
+    x = vaddq_u16(x, vdupq_n_u16(128));
+    x = vsraq_n_u16(x, x, 8);
+    return vshrn_n_u16(x, 8);
+}
+
+inline uint8x16_t mul_alpha_neon(uint8x16_t c, uint8x16_t a) {
+    const uint8x8_t lo = mul_alpha_u16(vmull_u8(vget_low_u8(c), vget_low_u8(a)));
+    const uint8x8_t hi = mul_alpha_u16(vmull_u8(vget_high_u8(c), vget_high_u8(a)));
+    return vcombine_u8(lo, hi);
+}
+
+#endif // HTML2NDI_HAVE_NEON
+
+// 16.16 fixed-point reciprocals of alpha, scaled by 255
+struct UnpremultiplyTable {
+    uint32_t inv[256];
+    UnpremultiplyTable() {
+        inv[0] = 0;
+        for (int a = 1; a < 256; a++) {
+            inv[a] = (255u << 16) / static_cast<uint32_t>(a);
+        }
+    }
+};
+
+} // anonymous namespace
+
+void bgra_premultiply(const uint8_t* bgra, int width, int height,
+                      uint8_t* out_bgra) {
+    const size_t pixels = static_cast<size_t>(width) * height;
+    size_t i = 0;
+
+#ifdef HTML2NDI_HAVE_NEON
+    for (; i + 16 <= pixels; i += 16) {
+        uint8x16x4_t px = vld4q_u8(bgra + i * 4);
+        const uint8x16_t a = px.val[3];
+        px.val[0] = mul_alpha_neon(px.val[0], a);
+        px.val[1] = mul_alpha_neon(px.val[1], a);
+        px.val[2] = mul_alpha_neon(px.val[2], a);
+        vst4q_u8(out_bgra + i * 4, px);
+    }
+#endif
+
+    for (; i < pixels; i++) {
+        const uint8_t* src = bgra + i * 4;
+        uint8_t* dst = out_bgra + i * 4;
+        const int a = src[3];
+        dst[0] = mul_alpha_scalar(src[0], a);
+        dst[1] = mul_alpha_scalar(src[1], a);
+        dst[2] = mul_alpha_scalar(src[2], a);
+        dst[3] = static_cast<uint8_t>(a);
+    }
+}
+
+void bgra_unpremultiply(const uint8_t* bgra, int width, int height,
+                        uint8_t* out_bgra) {
+    static const UnpremultiplyTable table;
+
+    const size_t pixels = static_cast<size_t>(width) * height;
+    for (size_t i = 0; i < pixels; i++) {
+        const uint8_t* src = bgra + i * 4;
+        uint8_t* dst = out_bgra + i * 4;
+        const uint32_t inv = table.inv[src[3]];
+        dst[0] = clamp_u8(static_cast<int>((src[0] * inv + 32768) >> 16));
+        dst[1] = clamp_u8(static_cast<int>((src[1] * inv + 32768) >> 16));
+        dst[2] = clamp_u8(static_cast<int>((src[2] * inv + 32768) >> 16));
+        dst[3] = src[3];
+    }
+}
+
+namespace {
+
+// 16 + round(c * 219 / 255): full range compressed onto 16-235
+inline uint8_t range_compress_scalar(int c) {
+    const int x = c * 219 + 128;
+    return static_cast<uint8_t>(((x + (x >> 8)) >> 8) + 16);
+}
+
+// clamp((c - 16) * 255 / 219) via the fixed-point factor 42/256
+// (1 + 42/256 = 1.1641 vs the exact 255/219 = 1.1644, well under 1 LSB
+// across the 16-235 input range; 235 lands exactly on 255)
+inline uint8_t range_expand_scalar(int c) {
+    const int x = c > 16 ? c - 16 : 0;
+    const int expanded = x + ((x * 42 + 128) >> 8);
+    return static_cast<uint8_t>(expanded > 255 ? 255 : expanded);
+}
+
+#ifdef HTML2NDI_HAVE_NEON
+
+// Same rounding as range_compress_scalar across 16 lanes
+inline uint8x16_t range_compress_neon(uint8x16_t c) {
+    const uint8x16_t k219 = vdupq_n_u8(219);
+    const uint8x8_t lo = mul_alpha_u16(vmull_u8(vget_low_u8(c), vget_low_u8(k219)));
+    const uint8x8_t hi = mul_alpha_u16(vmull_u8(vget_high_u8(c), vget_high_u8(k219)));
+    return vaddq_u8(vcombine_u8(lo, hi), vdupq_n_u8(16));
+}
+
+// Same math as range_expand_scalar: saturating add clamps super-white
+inline uint8x16_t range_expand_neon(uint8x16_t c) {
+    const uint8x16_t x = vqsubq_u8(c, vdupq_n_u8(16));
+    const uint8x16_t k42 = vdupq_n_u8(42);
+    uint16x8_t lo = vaddq_u16(vmull_u8(vget_low_u8(x), vget_low_u8(k42)),
+                              vdupq_n_u16(128));
+    uint16x8_t hi = vaddq_u16(vmull_u8(vget_high_u8(x), vget_high_u8(k42)),
+                              vdupq_n_u16(128));
+    const uint8x16_t frac = vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+    return vqaddq_u8(x, frac);
+}
+
+#endif // HTML2NDI_HAVE_NEON
+
+} // anonymous namespace
+
+void bgra_full_to_limited(const uint8_t* bgra, int width, int height,
+                          uint8_t* out_bgra) {
+    const size_t pixels = static_cast<size_t>(width) * height;
+    size_t i = 0;
+
+#ifdef HTML2NDI_HAVE_NEON
+    for (; i + 16 <= pixels; i += 16) {
+        uint8x16x4_t px = vld4q_u8(bgra + i * 4);
+        px.val[0] = range_compress_neon(px.val[0]);
+        px.val[1] = range_compress_neon(px.val[1]);
+        px.val[2] = range_compress_neon(px.val[2]);
+        vst4q_u8(out_bgra + i * 4, px);
+    }
+#endif
+
+    for (; i < pixels; i++) {
+        const uint8_t* src = bgra + i * 4;
+        uint8_t* dst = out_bgra + i * 4;
+        dst[0] = range_compress_scalar(src[0]);
+        dst[1] = range_compress_scalar(src[1]);
+        dst[2] = range_compress_scalar(src[2]);
+        dst[3] = src[3];
+    }
+}
+
+void bgra_limited_to_full(const uint8_t* bgra, int width, int height,
+                          uint8_t* out_bgra) {
+    const size_t pixels = static_cast<size_t>(width) * height;
+    size_t i = 0;
+
+#ifdef HTML2NDI_HAVE_NEON
+    for (; i + 16 <= pixels; i += 16) {
+        uint8x16x4_t px = vld4q_u8(bgra + i * 4);
+        px.val[0] = range_expand_neon(px.val[0]);
+        px.val[1] = range_expand_neon(px.val[1]);
+        px.val[2] = range_expand_neon(px.val[2]);
+        vst4q_u8(out_bgra + i * 4, px);
+    }
+#endif
+
+    for (; i < pixels; i++) {
+        const uint8_t* src = bgra + i * 4;
+        uint8_t* dst = out_bgra + i * 4;
+        dst[0] = range_expand_scalar(src[0]);
+        dst[1] = range_expand_scalar(src[1]);
+        dst[2] = range_expand_scalar(src[2]);
+        dst[3] = src[3];
+    }
+}
+
+void bgra_extract_field(const uint8_t* bgra, int width, int height,
+                        bool top_field, uint8_t* out_field) {
+    const size_t row_bytes = static_cast<size_t>(width) * 4;
+    const int first_row = top_field ? 0 : 1;
+    for (int y = first_row; y < height; y += 2) {
+        std::memcpy(out_field, bgra + static_cast<size_t>(y) * row_bytes,
+                    row_bytes);
+        out_field += row_bytes;
+    }
+}
+
+} // namespace html2ndi
@@ -0,0 +1,141 @@
+/**
+ * Proxy stream implementation.
+ * Downscales the program output and sends it on a second NDI source.
+ */
+
+#include "html2ndi/ndi/proxy_stream.h"
+#include "html2ndi/ndi/ndi_sender.h"
+#include "html2ndi/utils/image_encode.h"
+#include "html2ndi/utils/logger.h"
+#include "html2ndi/utils/watchdog.h"
+
+#include <chrono>
+
+namespace html2ndi {
+
+ProxyStream::ProxyStream(std::string ndi_name, std::string ndi_groups,
+                         int proxy_width, int proxy_fps,
+                         FrameProvider frame_provider,
+                         GenerationProvider generation_provider)
+    : ndi_name_(std::move(ndi_name))
+    , ndi_groups_(std::move(ndi_groups))
+    , proxy_width_(proxy_width)
+    , proxy_fps_(proxy_fps)
+    , frame_provider_(std::move(frame_provider))
+    , generation_provider_(std::move(generation_provider)) {
+}
+
+ProxyStream::~ProxyStream() {
+    stop();
+}
+
+bool ProxyStream::initialize() {
+    sender_ = std::make_unique<NdiSender>(ndi_name_, ndi_groups_);
+    // Synchronous sends: the scratch buffer is rewritten on the next
+    // downscale, so the SDK must be done with it when send returns. At
+    // proxy rates the blocking cost is irrelevant.
+    sender_->set_async_send(false);
+    if (!sender_->initialize()) {
+        LOG_ERROR("Failed to initialize proxy NDI sender '%s'",
+                  ndi_name_.c_str());
+        sender_.reset();
+        return false;
+    }
+    return true;
+}
+
+void ProxyStream::start() {
+    if (running_ || !sender_) {
+        return;
+    }
+    running_ = true;
+    thread_ = std::thread(&ProxyStream::proxy_thread, this);
+    LOG_INFO("Proxy stream started: '%s' at %d px wide, %d fps",
+             ndi_name_.c_str(), proxy_width_, proxy_fps_);
+}
+
+void ProxyStream::stop() {
+    if (running_) {
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        LOG_INFO("Proxy stream stopped (%llu frames sent)",
+                 static_cast<unsigned long long>(frames_sent_.load()));
+    }
+    if (sender_) {
+        sender_->shutdown();
+        sender_.reset();
+    }
+}
+
+void ProxyStream::proxy_thread() {
+    LOG_DEBUG("Proxy stream thread started");
+    Watchdog::register_current_thread("proxy");
+
+    const auto interval = std::chrono::nanoseconds(
+        1'000'000'000LL / (proxy_fps_ > 0 ? proxy_fps_ : 15));
+
+    uint64_t last_generation = 0;
+    bool sent_once = false;
+    auto last_send_time = std::chrono::steady_clock::now();
+    std::vector<uint8_t> frame;
+    std::vector<uint8_t> scaled;
+    int scaled_width = 0;
+    int scaled_height = 0;
+
+    while (running_) {
+        auto tick_start = std::chrono::steady_clock::now();
+
+        const uint64_t generation = generation_provider_();
+        const bool changed = !sent_once || generation != last_generation;
+
+        if (changed) {
+            int width = 0, height = 0;
+            if (frame_provider_(frame, width, height) && width > 0 && height > 0) {
+                last_generation = generation;
+                sent_once = true;
+
+                if (width > proxy_width_) {
+                    scaled_width = proxy_width_;
+                    scaled_height = height * proxy_width_ / width;
+                    if (scaled_height < 2) {
+                        scaled_height = 2;
+                    }
+                    scaled_height &= ~1;  // Even height for codec friendliness
+                    scaled.resize(static_cast<size_t>(scaled_width) *
+                                  scaled_height * 4);
+                    scale_bgra_box(frame.data(), width, height,
+                                   scaled.data(), scaled_width, scaled_height);
+                } else {
+                    // Program already at/below proxy width: pass through
+                    scaled_width = width;
+                    scaled_height = height;
+                    scaled.assign(frame.begin(), frame.end());
+                }
+
+                sender_->send_video_frame(scaled.data(), scaled_width,
+                                          scaled_height, proxy_fps_, 1);
+                frames_sent_++;
+                last_send_time = tick_start;
+            }
+        } else if (sent_once &&
+                   tick_start - last_send_time >= std::chrono::seconds(1)) {
+            // Static content: one keepalive per second so receivers do not
+            // treat the source as gone, instead of the full proxy rate
+            sender_->send_video_frame(scaled.data(), scaled_width,
+                                      scaled_height, proxy_fps_, 1);
+            frames_sent_++;
+            last_send_time = tick_start;
+        } else {
+            frames_skipped_++;
+        }
+
+        std::this_thread::sleep_until(tick_start + interval);
+    }
+
+    Watchdog::unregister_current_thread();
+    LOG_DEBUG("Proxy stream thread exited");
+}
+
+} // namespace html2ndi
@@ -4,8 +4,10 @@
 
 #include "html2ndi/utils/logger.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <filesystem>
 #include <iomanip>
@@ -20,6 +22,93 @@
 
 namespace html2ndi {
 
+/**
+ * Bounded lock-free MPSC ring for preformatted log records.
+ *
+ * Cells carry a sequence number (Vyukov-style bounded queue): producers
+ * claim a cell with a CAS on the enqueue position and publish it by
+ * bumping the cell sequence; the single consumer (drain thread) reads in
+ * order and recycles cells by advancing their sequence a full lap. A
+ * producer that finds its cell still occupied reports the ring as full
+ * instead of waiting, so frame-path callers never block.
+ */
+class Logger::LogRing {
+public:
+    static constexpr size_t kSize = 1024;           // Must be a power of two
+    static constexpr size_t kTextCapacity = 2048;   // Per-record payload
+
+    struct Record {
+        std::atomic<size_t> sequence;
+        LogLevel level;
+        uint16_t length;          // Bytes of text (may be truncated)
+        uint16_t message_offset;  // Start of the raw message within text
+        char text[kTextCapacity];
+    };
+
+    LogRing() {
+        for (size_t i = 0; i < kSize; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(LogLevel level, const std::string& line, size_t message_offset) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Record* cell;
+        for (;;) {
+            cell = &cells_[pos & (kSize - 1)];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (dif == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false;  // Ring full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        size_t length = std::min(line.size(), kTextCapacity - 1);
+        std::memcpy(cell->text, line.data(), length);
+        cell->text[length] = '\0';
+        cell->level = level;
+        cell->length = static_cast<uint16_t>(length);
+        cell->message_offset = static_cast<uint16_t>(
+            std::min(message_offset, length));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Single-consumer pop; returns false when the ring is empty
+    bool pop(Record& out) {
+        Record& cell = cells_[dequeue_pos_ & (kSize - 1)];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) -
+            static_cast<intptr_t>(dequeue_pos_ + 1) < 0) {
+            return false;
+        }
+
+        out.level = cell.level;
+        out.length = cell.length;
+        out.message_offset = cell.message_offset;
+        std::memcpy(out.text, cell.text, cell.length + 1);
+        cell.sequence.store(dequeue_pos_ + kSize, std::memory_order_release);
+        dequeue_pos_++;
+        return true;
+    }
+
+    bool empty() const {
+        return dequeue_pos_ == enqueue_pos_.load(std::memory_order_acquire);
+    }
+
+private:
+    Record cells_[kSize];
+    std::atomic<size_t> enqueue_pos_{0};
+    size_t dequeue_pos_{0};  // Drain thread only
+};
+
 std::string get_default_log_directory() {
 #ifdef __APPLE__
     // Get home directory
@@ -52,6 +141,7 @@ Logger::Logger() {
 }
 
 Logger::~Logger() {
+    set_async(false);  // Joins the drain thread after it empties the ring
     flush();
     if (file_.is_open()) {
         file_.close();
@@ -115,62 +205,111 @@ void Logger::vlog(LogLevel level, const char* format, va_list args) {
     timestamp << std::put_time(&tm, "%Y-%m-%d %H:%M:%S")
               << '.' << std::setfill('0') << std::setw(3) << ms.count();
     
-    // Level string
+    // Level string (colors are applied at emit time)
     const char* level_str;
-    const char* color_start = "";
-    const char* color_end = "\033[0m";
-    
     switch (level) {
-        case LogLevel::DEBUG:
-            level_str = "DEBUG";
-            color_start = "\033[36m"; // Cyan
-            break;
-        case LogLevel::INFO:
-            level_str = "INFO ";
-            color_start = "\033[32m"; // Green
-            break;
-        case LogLevel::WARNING:
-            level_str = "WARN ";
-            color_start = "\033[33m"; // Yellow
-            break;
-        case LogLevel::ERROR:
-            level_str = "ERROR";
-            color_start = "\033[31m"; // Red
-            break;
-        case LogLevel::FATAL:
-            level_str = "FATAL";
-            color_start = "\033[35m"; // Magenta
-            break;
-        default:
-            level_str = "?????";
-            color_start = "";
-            color_end = "";
+        case LogLevel::DEBUG:   level_str = "DEBUG"; break;
+        case LogLevel::INFO:    level_str = "INFO "; break;
+        case LogLevel::WARNING: level_str = "WARN "; break;
+        case LogLevel::ERROR:   level_str = "ERROR"; break;
+        case LogLevel::FATAL:   level_str = "FATAL"; break;
+        default:                level_str = "?????";
     }
-    
+
     // Format log line
     std::ostringstream log_line;
     log_line << "[" << timestamp.str() << "] [" << level_str << "] " << message;
-    
+
     std::string line = log_line.str();
-    
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        // Output to console with colors
-        if (isatty(fileno(stderr))) {
-            std::cerr << color_start << line << color_end << std::endl;
-        } else {
-            std::cerr << line << std::endl;
+
+    // Async mode: hand the preformatted record to the drain thread so
+    // this caller never touches console/file/os_log I/O
+    if (async_running_) {
+        const size_t message_offset = line.size() - std::strlen(message);
+        if (!ring_->push(level, line, message_offset)) {
+            dropped_records_++;
         }
-        
-        // Output to file without colors
-        if (file_.is_open()) {
-            file_ << line << std::endl;
-            rotate_file_if_needed();
+        return;
+    }
+
+    emit(level, line.c_str(), message);
+}
+
+void Logger::emit(LogLevel level, const char* line, const char* message) {
+    const char* color_start = "";
+    const char* color_end = "\033[0m";
+    switch (level) {
+        case LogLevel::DEBUG:   color_start = "\033[36m"; break;  // Cyan
+        case LogLevel::INFO:    color_start = "\033[32m"; break;  // Green
+        case LogLevel::WARNING: color_start = "\033[33m"; break;  // Yellow
+        case LogLevel::ERROR:   color_start = "\033[31m"; break;  // Red
+        case LogLevel::FATAL:   color_start = "\033[35m"; break;  // Magenta
+        default:                color_end = "";
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Output to console with colors
+    if (isatty(fileno(stderr))) {
+        std::cerr << color_start << line << color_end << std::endl;
+    } else {
+        std::cerr << line << std::endl;
+    }
+
+    // Output to file without colors
+    if (file_.is_open()) {
+        file_ << line << std::endl;
+        rotate_file_if_needed();
+    }
+
+    // Output to macOS unified logging (Console.app)
+    log_to_os(level, message);
+}
+
+void Logger::set_async(bool enabled) {
+    if (enabled == async_running_) {
+        return;
+    }
+
+    if (enabled) {
+        if (!ring_) {
+            ring_ = std::make_unique<LogRing>();
+        }
+        async_running_ = true;
+        drain_thread_ = std::thread(&Logger::drain_loop, this);
+    } else {
+        async_running_ = false;
+        if (drain_thread_.joinable()) {
+            drain_thread_.join();
+        }
+    }
+}
+
+void Logger::drain_loop() {
+    LogRing::Record record;
+
+    // Keep draining after shutdown is requested until the ring is empty
+    while (async_running_ || !ring_->empty()) {
+        bool drained_any = false;
+        while (ring_->pop(record)) {
+            emit(record.level, record.text, record.text + record.message_offset);
+            drained_any = true;
+        }
+
+        // Surface overflow so a silent gap in the log is explainable
+        const uint64_t dropped = dropped_records_;
+        if (dropped != dropped_reported_) {
+            char note[128];
+            snprintf(note, sizeof(note),
+                     "Async log ring overflow: %llu records dropped so far",
+                     static_cast<unsigned long long>(dropped));
+            emit(LogLevel::WARNING, note, note);
+            dropped_reported_ = dropped;
+        }
+
+        if (!drained_any) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
-        
-        // Output to macOS unified logging (Console.app)
-        log_to_os(level, message);
     }
 }
 
@@ -207,8 +346,18 @@ void Logger::log_to_os(LogLevel level, const char* message) {
 }
 
 void Logger::flush() {
+    // Let the drain thread catch up so flushed output is complete
+    if (async_running_ && ring_) {
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::seconds(1);
+        while (!ring_->empty() &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
-    
+
     if (file_.is_open()) {
         file_.flush();
     }
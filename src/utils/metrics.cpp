@@ -0,0 +1,59 @@
+/**
+ * Metrics registry implementation.
+ */
+
+#include "html2ndi/utils/metrics.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace html2ndi {
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+void MetricsRegistry::register_metric(const std::string& name, const std::string& help,
+                                      Type type, Sampler sampler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& metric : metrics_) {
+        if (metric.name == name) {
+            metric.help = help;
+            metric.type = type;
+            metric.sampler = std::move(sampler);
+            return;
+        }
+    }
+    metrics_.push_back({name, help, type, std::move(sampler)});
+}
+
+void MetricsRegistry::unregister_metric(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    metrics_.erase(
+        std::remove_if(metrics_.begin(), metrics_.end(),
+                       [&name](const Metric& m) { return m.name == name; }),
+        metrics_.end());
+}
+
+std::string MetricsRegistry::render() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string out;
+    out.reserve(metrics_.size() * 128);
+
+    for (const auto& metric : metrics_) {
+        out += "# HELP " + metric.name + " " + metric.help + "\n";
+        out += "# TYPE " + metric.name + " ";
+        out += (metric.type == Type::Counter) ? "counter" : "gauge";
+        out += "\n";
+
+        char value[64];
+        snprintf(value, sizeof(value), "%.15g", metric.sampler ? metric.sampler() : 0.0);
+        out += metric.name + " " + value + "\n";
+    }
+
+    return out;
+}
+
+} // namespace html2ndi
@@ -0,0 +1,185 @@
+/**
+ * Shared-memory preview publisher implementation.
+ */
+
+#include "html2ndi/utils/shm_preview.h"
+#include "html2ndi/utils/image_encode.h"
+#include "html2ndi/utils/logger.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace html2ndi {
+
+ShmPreview::ShmPreview(std::string name, int preview_width, int publish_fps,
+                       FrameProvider frame_provider,
+                       GenerationProvider generation_provider)
+    : name_(std::move(name))
+    , preview_width_(preview_width)
+    , publish_fps_(publish_fps)
+    , frame_provider_(std::move(frame_provider))
+    , generation_provider_(std::move(generation_provider)) {
+}
+
+ShmPreview::~ShmPreview() {
+    stop();
+    shutdown();
+}
+
+bool ShmPreview::initialize() {
+    // Size the payload for the preview width at up to square aspect;
+    // readers take the actual geometry from the header each frame
+    payload_capacity_ = static_cast<size_t>(preview_width_) * preview_width_ * 4;
+    mapped_size_ = sizeof(Header) + payload_capacity_;
+
+    // Stale segment from a crashed worker with the same name
+    shm_unlink(name_.c_str());
+
+    fd_ = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd_ < 0) {
+        LOG_ERROR("shm_open(%s) failed: %s", name_.c_str(), strerror(errno));
+        return false;
+    }
+
+    if (ftruncate(fd_, static_cast<off_t>(mapped_size_)) != 0) {
+        LOG_ERROR("ftruncate(%s, %zu) failed: %s",
+                  name_.c_str(), mapped_size_, strerror(errno));
+        shutdown();
+        return false;
+    }
+
+    void* mem = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd_, 0);
+    if (mem == MAP_FAILED) {
+        LOG_ERROR("mmap(%s) failed: %s", name_.c_str(), strerror(errno));
+        shutdown();
+        return false;
+    }
+
+    header_ = static_cast<Header*>(mem);
+    pixels_ = static_cast<uint8_t*>(mem) + sizeof(Header);
+
+    std::memset(header_, 0, sizeof(Header));
+    header_->magic = kMagic;
+    header_->version = kVersion;
+
+    LOG_INFO("Shared-memory preview segment %s mapped (%zu bytes)",
+             name_.c_str(), mapped_size_);
+    return true;
+}
+
+void ShmPreview::start() {
+    if (running_ || !header_) {
+        return;
+    }
+
+    LOG_DEBUG("Starting shm preview publisher at %d fps (width %d)",
+              publish_fps_, preview_width_);
+
+    running_ = true;
+    thread_ = std::thread(&ShmPreview::publisher_thread, this);
+}
+
+void ShmPreview::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    LOG_DEBUG("Shm preview publisher stopped. Published: %llu",
+              static_cast<unsigned long long>(frames_published_.load()));
+}
+
+void ShmPreview::shutdown() {
+    if (header_) {
+        munmap(header_, mapped_size_);
+        header_ = nullptr;
+        pixels_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+        shm_unlink(name_.c_str());
+    }
+}
+
+void ShmPreview::publisher_thread() {
+    const auto interval = std::chrono::nanoseconds(
+        1'000'000'000LL / (publish_fps_ > 0 ? publish_fps_ : 30));
+
+    uint64_t last_generation = 0;
+    bool published_once = false;
+    std::vector<uint8_t> frame;
+    std::vector<uint8_t> scaled;
+
+    while (running_) {
+        auto tick_start = std::chrono::steady_clock::now();
+
+        const uint64_t generation = generation_provider_();
+        if (!published_once || generation != last_generation) {
+            int width = 0, height = 0;
+            if (frame_provider_(frame, width, height) && width > 0 && height > 0) {
+                last_generation = generation;
+                published_once = true;
+
+                if (width > preview_width_) {
+                    int target_height = height * preview_width_ / width;
+                    if (target_height < 1) {
+                        target_height = 1;
+                    }
+                    if (target_height > preview_width_) {
+                        // Taller than square: clamp to the payload capacity
+                        target_height = preview_width_;
+                    }
+                    scaled.resize(static_cast<size_t>(preview_width_) *
+                                  target_height * 4);
+                    scale_bgra_box(frame.data(), width, height,
+                                   scaled.data(), preview_width_, target_height);
+                    publish(scaled.data(), preview_width_, target_height);
+                } else {
+                    publish(frame.data(), width, height);
+                }
+            }
+        }
+
+        std::this_thread::sleep_until(tick_start + interval);
+    }
+}
+
+void ShmPreview::publish(const uint8_t* bgra_data, int width, int height) {
+    const size_t bytes = static_cast<size_t>(width) * height * 4;
+    if (bytes > payload_capacity_) {
+        LOG_WARNING("Preview frame %dx%d exceeds shm payload capacity, skipped",
+                    width, height);
+        return;
+    }
+
+    const auto now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // Seqlock write section: readers retry while the sequence is odd or
+    // changed across their copy
+    header_->sequence.fetch_add(1, std::memory_order_acq_rel);
+
+    header_->width = width;
+    header_->height = height;
+    header_->stride = width * 4;
+    header_->frame_number++;
+    header_->timestamp_us = static_cast<uint64_t>(now_us);
+    std::memcpy(pixels_, bgra_data, bytes);
+
+    header_->sequence.fetch_add(1, std::memory_order_acq_rel);
+
+    frames_published_++;
+}
+
+} // namespace html2ndi
@@ -0,0 +1,148 @@
+/**
+ * VideoToolbox-backed JPEG encoder for the streaming preview path.
+ */
+
+#include "html2ndi/utils/vt_jpeg_encoder.h"
+#include "html2ndi/utils/image_encode.h"
+#include "html2ndi/utils/logger.h"
+
+#ifdef __APPLE__
+#include <VideoToolbox/VideoToolbox.h>
+#include <CoreMedia/CoreMedia.h>
+#include <CoreVideo/CoreVideo.h>
+#endif
+
+namespace html2ndi {
+
+#ifdef __APPLE__
+
+namespace {
+
+// Filled in by the compression callback for one synchronous encode
+struct EncodeOutput {
+    std::vector<uint8_t>* jpeg{nullptr};
+    bool ok{false};
+};
+
+void compression_callback(void* /*refcon*/, void* source_ref, OSStatus status,
+                          VTEncodeInfoFlags /*flags*/, CMSampleBufferRef sample) {
+    auto* output = static_cast<EncodeOutput*>(source_ref);
+    if (!output || status != noErr || !sample) {
+        return;
+    }
+
+    CMBlockBufferRef block = CMSampleBufferGetDataBuffer(sample);
+    if (!block) {
+        return;
+    }
+
+    const size_t length = CMBlockBufferGetDataLength(block);
+    output->jpeg->resize(length);
+    if (CMBlockBufferCopyDataBytes(block, 0, length, output->jpeg->data()) == kCMBlockBufferNoErr) {
+        output->ok = true;
+    }
+}
+
+} // namespace
+
+VtJpegEncoder::VtJpegEncoder() = default;
+
+VtJpegEncoder::~VtJpegEncoder() {
+    destroy_session();
+}
+
+bool VtJpegEncoder::ensure_session(int width, int height, int quality) {
+    if (session_ && session_width_ == width && session_height_ == height &&
+        session_quality_ == quality) {
+        return true;
+    }
+    destroy_session();
+
+    VTCompressionSessionRef session = nullptr;
+    OSStatus status = VTCompressionSessionCreate(
+        kCFAllocatorDefault, width, height, kCMVideoCodecType_JPEG,
+        nullptr, nullptr, nullptr, compression_callback, nullptr, &session);
+    if (status != noErr || !session) {
+        LOG_WARNING("VideoToolbox JPEG session creation failed (status %d), "
+                    "preview falls back to software encode", static_cast<int>(status));
+        return false;
+    }
+
+    const float quality_fraction = static_cast<float>(quality) / 100.0f;
+    CFNumberRef quality_ref = CFNumberCreate(kCFAllocatorDefault, kCFNumberFloat32Type,
+                                             &quality_fraction);
+    VTSessionSetProperty(session, kVTCompressionPropertyKey_Quality, quality_ref);
+    CFRelease(quality_ref);
+    VTSessionSetProperty(session, kVTCompressionPropertyKey_RealTime, kCFBooleanTrue);
+
+    session_ = session;
+    session_width_ = width;
+    session_height_ = height;
+    session_quality_ = quality;
+    return true;
+}
+
+void VtJpegEncoder::destroy_session() {
+    if (session_) {
+        auto session = static_cast<VTCompressionSessionRef>(session_);
+        VTCompressionSessionInvalidate(session);
+        CFRelease(session);
+        session_ = nullptr;
+    }
+}
+
+bool VtJpegEncoder::encode(const uint8_t* bgra_data, int width, int height,
+                           int quality, std::vector<uint8_t>& out_jpeg) {
+    if (!ensure_session(width, height, quality)) {
+        hardware_active_ = false;
+        return encode_jpeg(bgra_data, width, height, quality, out_jpeg);
+    }
+
+    auto session = static_cast<VTCompressionSessionRef>(session_);
+
+    // Wrap the caller's pixels without copying. The encode is completed
+    // synchronously below, so the bytes only need to stay valid for this call.
+    CVPixelBufferRef pixel_buffer = nullptr;
+    CVReturn cv_status = CVPixelBufferCreateWithBytes(
+        kCFAllocatorDefault, width, height, kCVPixelFormatType_32BGRA,
+        const_cast<uint8_t*>(bgra_data), static_cast<size_t>(width) * 4,
+        nullptr, nullptr, nullptr, &pixel_buffer);
+    if (cv_status != kCVReturnSuccess) {
+        hardware_active_ = false;
+        return encode_jpeg(bgra_data, width, height, quality, out_jpeg);
+    }
+
+    out_jpeg.clear();
+    EncodeOutput output;
+    output.jpeg = &out_jpeg;
+
+    const CMTime pts = CMTimeMake(frame_number_++, 1000);
+    OSStatus status = VTCompressionSessionEncodeFrame(
+        session, pixel_buffer, pts, kCMTimeInvalid, nullptr, &output, nullptr);
+    if (status == noErr) {
+        VTCompressionSessionCompleteFrames(session, kCMTimeInvalid);
+    }
+    CVPixelBufferRelease(pixel_buffer);
+
+    if (status != noErr || !output.ok) {
+        hardware_active_ = false;
+        return encode_jpeg(bgra_data, width, height, quality, out_jpeg);
+    }
+
+    hardware_active_ = true;
+    return true;
+}
+
+#else // !__APPLE__
+
+VtJpegEncoder::VtJpegEncoder() = default;
+VtJpegEncoder::~VtJpegEncoder() = default;
+
+bool VtJpegEncoder::encode(const uint8_t* bgra_data, int width, int height,
+                           int quality, std::vector<uint8_t>& out_jpeg) {
+    return encode_jpeg(bgra_data, width, height, quality, out_jpeg);
+}
+
+#endif // __APPLE__
+
+} // namespace html2ndi
@@ -6,9 +6,57 @@
 #include "html2ndi/utils/logger.h"
 
 #include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <csignal>
+#include <execinfo.h>
+#include <pthread.h>
 
 namespace html2ndi {
 
+namespace {
+
+// Process-wide registry of threads eligible for stall backtrace capture.
+// Threads register once at startup and live for the process lifetime.
+struct RegisteredThread {
+    pthread_t tid;
+    char name[32];
+};
+
+std::mutex g_registry_mutex;
+std::vector<RegisteredThread> g_registered_threads;
+
+// Capture rendezvous: the watchdog thread signals one target at a time
+// and waits for the handler to fill the shared frame buffer
+constexpr int kMaxFrames = 64;
+void* g_capture_frames[kMaxFrames];
+std::atomic<int> g_capture_depth{0};
+std::atomic<bool> g_capture_done{false};
+
+void backtrace_signal_handler(int) {
+    // backtrace() is not formally async-signal-safe, but this is the
+    // standard sampling-profiler technique and is reliable on macOS
+    int depth = backtrace(g_capture_frames, kMaxFrames);
+    g_capture_depth.store(depth, std::memory_order_release);
+    g_capture_done.store(true, std::memory_order_release);
+}
+
+void install_capture_handler() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        struct sigaction sa;
+        std::memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = backtrace_signal_handler;
+        sa.sa_flags = SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGPROF, &sa, nullptr);
+    });
+}
+
+} // namespace
+
 Watchdog::Watchdog(std::chrono::seconds timeout, TimeoutCallback callback)
     : timeout_(timeout)
     , callback_(std::move(callback)) {
@@ -22,13 +70,13 @@ void Watchdog::start() {
     if (running_) {
         return;
     }
-    
-    LOG_INFO("Starting watchdog timer (timeout: %llds)", 
+
+    LOG_INFO("Starting watchdog timer (timeout: %llds)",
              static_cast<long long>(timeout_.count()));
-    
+
     running_ = true;
     heartbeat(); // Initial heartbeat
-    
+
     thread_ = std::thread(&Watchdog::watchdog_thread, this);
 }
 
@@ -36,10 +84,10 @@ void Watchdog::stop() {
     if (!running_) {
         return;
     }
-    
+
     LOG_DEBUG("Stopping watchdog timer");
     running_ = false;
-    
+
     if (thread_.joinable()) {
         thread_.join();
     }
@@ -47,7 +95,29 @@ void Watchdog::stop() {
 
 void Watchdog::heartbeat() {
     auto now = std::chrono::steady_clock::now().time_since_epoch();
-    last_heartbeat_ = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+    auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+
+    // Track the interval distribution so sub-timeout stutters show up
+    // in /status even when no stall report fired
+    const uint64_t prev = last_heartbeat_.exchange(now_ms);
+    if (heartbeat_seen_.exchange(true)) {
+        const int64_t interval = now_ms - static_cast<int64_t>(prev);
+
+        int64_t prev_max = max_interval_ms_.load();
+        while (interval > prev_max &&
+               !max_interval_ms_.compare_exchange_weak(prev_max, interval)) {
+        }
+
+        const auto& bounds = interval_bucket_bounds_ms();
+        int bucket = kIntervalBuckets - 1;
+        for (int i = 0; i < kIntervalBuckets - 1; i++) {
+            if (interval < bounds[i]) {
+                bucket = i;
+                break;
+            }
+        }
+        interval_buckets_[bucket]++;
+    }
 }
 
 std::chrono::milliseconds Watchdog::time_since_heartbeat() const {
@@ -56,25 +126,132 @@ std::chrono::milliseconds Watchdog::time_since_heartbeat() const {
     return std::chrono::milliseconds(now_ms - last_heartbeat_.load());
 }
 
+void Watchdog::set_stall_threshold(std::chrono::milliseconds threshold) {
+    if (threshold.count() < 0) {
+        LOG_WARNING("Invalid stall threshold %lld ms ignored",
+                    static_cast<long long>(threshold.count()));
+        return;
+    }
+    stall_threshold_ms_ = threshold.count();
+    if (threshold.count() > 0) {
+        install_capture_handler();
+    }
+}
+
+std::array<uint64_t, Watchdog::kIntervalBuckets> Watchdog::interval_histogram() const {
+    std::array<uint64_t, kIntervalBuckets> counts;
+    for (int i = 0; i < kIntervalBuckets; i++) {
+        counts[i] = interval_buckets_[i].load();
+    }
+    return counts;
+}
+
+const std::array<int64_t, Watchdog::kIntervalBuckets - 1>& Watchdog::interval_bucket_bounds_ms() {
+    static const std::array<int64_t, kIntervalBuckets - 1> bounds = {
+        5, 10, 25, 50, 100, 250, 500
+    };
+    return bounds;
+}
+
+void Watchdog::register_current_thread(const char* name) {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    RegisteredThread entry;
+    entry.tid = pthread_self();
+    std::strncpy(entry.name, name, sizeof(entry.name) - 1);
+    entry.name[sizeof(entry.name) - 1] = '\0';
+    g_registered_threads.push_back(entry);
+    LOG_DEBUG("Registered thread '%s' for stall capture", entry.name);
+}
+
+void Watchdog::unregister_current_thread() {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    const pthread_t self = pthread_self();
+    for (auto it = g_registered_threads.begin();
+         it != g_registered_threads.end(); ++it) {
+        if (pthread_equal(it->tid, self)) {
+            g_registered_threads.erase(it);
+            return;
+        }
+    }
+}
+
+void Watchdog::capture_stall_backtraces(int64_t stalled_ms) {
+    LOG_WARNING("Heartbeat stall in progress: %lld ms without heartbeat "
+                "(threshold: %lld ms), capturing thread backtraces",
+                static_cast<long long>(stalled_ms),
+                static_cast<long long>(stall_threshold_ms_.load()));
+
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    for (const auto& thread : g_registered_threads) {
+        g_capture_done.store(false, std::memory_order_release);
+        if (pthread_kill(thread.tid, SIGPROF) != 0) {
+            LOG_WARNING("Stall capture: could not signal thread '%s'", thread.name);
+            continue;
+        }
+
+        // Wait briefly for the handler; a thread stuck in the kernel may
+        // not run the handler until it returns to user space
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(100);
+        while (!g_capture_done.load(std::memory_order_acquire) &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        if (!g_capture_done.load(std::memory_order_acquire)) {
+            LOG_WARNING("Stall capture: thread '%s' did not respond "
+                        "(likely blocked in a syscall)", thread.name);
+            continue;
+        }
+
+        const int depth = g_capture_depth.load(std::memory_order_acquire);
+        char** symbols = backtrace_symbols(g_capture_frames, depth);
+        LOG_WARNING("Backtrace of thread '%s' (%d frames):", thread.name, depth);
+        for (int i = 0; i < depth; i++) {
+            LOG_WARNING("  #%-2d %s", i, symbols ? symbols[i] : "?");
+        }
+        free(symbols);
+    }
+}
+
 void Watchdog::watchdog_thread() {
     LOG_DEBUG("Watchdog thread started");
-    
+
     while (running_) {
-        // Sleep for 1 second intervals to allow responsive shutdown
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        
+        // Poll finely enough to catch soft stalls while they are still
+        // in progress; fall back to coarse ticks when profiling is off
+        const int64_t soft_ms = stall_threshold_ms_.load();
+        if (soft_ms > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        } else {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+
         if (!running_) {
             break;
         }
-        
+
         auto elapsed = time_since_heartbeat();
         auto timeout_ms = std::chrono::duration_cast<std::chrono::milliseconds>(timeout_);
-        
+
+        // Soft stall: over the profiling threshold but under the hard
+        // timeout. Report each stall once, keyed on the heartbeat that
+        // preceded it.
+        if (soft_ms > 0 && elapsed.count() > soft_ms &&
+            elapsed <= timeout_ms) {
+            const uint64_t epoch = last_heartbeat_.load();
+            if (epoch != stall_reported_epoch_) {
+                stall_reported_epoch_ = epoch;
+                stall_count_++;
+                capture_stall_backtraces(elapsed.count());
+            }
+        }
+
         if (elapsed > timeout_ms) {
             LOG_FATAL("Watchdog timeout! No heartbeat for %lldms (timeout: %lldms)",
                       static_cast<long long>(elapsed.count()),
                       static_cast<long long>(timeout_ms.count()));
-            
+
             if (callback_) {
                 // Call custom callback
                 callback_();
@@ -83,18 +260,14 @@ void Watchdog::watchdog_thread() {
                 LOG_FATAL("Main loop hung - aborting process");
                 std::abort();
             }
-            
+
             // Stop after triggering
             running_ = false;
             break;
         }
     }
-    
+
     LOG_DEBUG("Watchdog thread exited");
 }
 
 } // namespace html2ndi
-
-
-
-
@@ -0,0 +1,186 @@
+/**
+ * Unit tests for the audio pump (SPSC capture ring + drain thread)
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "html2ndi/ndi/audio_pump.h"
+
+using namespace html2ndi;
+
+namespace {
+
+// Collects everything the pump hands to the sink, the way NdiSender would
+struct SinkCapture {
+    std::mutex mutex;
+    std::vector<float> planar;
+    int sample_rate{0};
+    int channels{0};
+    std::atomic<int> calls{0};
+
+    AudioPump::AudioSink sink() {
+        return [this](const float* data, int rate, int ch, int samples) {
+            std::lock_guard<std::mutex> lock(mutex);
+            sample_rate = rate;
+            channels = ch;
+            planar.insert(planar.end(), data,
+                          data + static_cast<size_t>(ch) * samples);
+            calls++;
+        };
+    }
+};
+
+// Build a two-channel planar packet with distinguishable samples
+void make_packet(std::vector<float>& left, std::vector<float>& right,
+                 const float** pointers, int frames, float base) {
+    left.resize(frames);
+    right.resize(frames);
+    for (int i = 0; i < frames; i++) {
+        left[i] = base + i;
+        right[i] = -(base + i);
+    }
+    pointers[0] = left.data();
+    pointers[1] = right.data();
+}
+
+} // namespace
+
+TEST(AudioPumpTest, PacketsBeforeStreamStartAreIgnored) {
+    SinkCapture capture;
+    AudioPump pump(capture.sink(), 60, 1);
+
+    std::vector<float> left, right;
+    const float* data[2];
+    make_packet(left, right, data, 16, 1.0f);
+    pump.push_packet(data, 16);
+
+    EXPECT_EQ(pump.packets_received(), 0u);
+    EXPECT_EQ(pump.queued_frames(), 0u);
+}
+
+TEST(AudioPumpTest, DrainsQueuedSamplesAsPlanar) {
+    SinkCapture capture;
+    AudioPump pump(capture.sink(), 60, 1);
+
+    pump.on_stream_started(48000, 2);
+
+    std::vector<float> left, right;
+    const float* data[2];
+    make_packet(left, right, data, 32, 100.0f);
+    pump.push_packet(data, 32);
+    EXPECT_EQ(pump.queued_frames(), 32u);
+
+    pump.start();
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::seconds(1);
+    while (capture.calls == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    pump.stop();
+
+    ASSERT_GE(capture.calls.load(), 1);
+    EXPECT_EQ(capture.sample_rate, 48000);
+    EXPECT_EQ(capture.channels, 2);
+    ASSERT_EQ(capture.planar.size(), 64u);
+
+    // Planar layout: all left samples, then all right samples
+    for (int i = 0; i < 32; i++) {
+        EXPECT_FLOAT_EQ(capture.planar[i], 100.0f + i);
+        EXPECT_FLOAT_EQ(capture.planar[32 + i], -(100.0f + i));
+    }
+    EXPECT_EQ(pump.frames_sent(), 32u);
+    EXPECT_EQ(pump.queued_frames(), 0u);
+}
+
+TEST(AudioPumpTest, FullRingDropsAndCounts) {
+    SinkCapture capture;
+    AudioPump pump(capture.sink(), 60, 1);
+
+    // Ring capacity rounds the sample rate up to a power of two: 64 frames
+    pump.on_stream_started(64, 2);
+
+    std::vector<float> left, right;
+    const float* data[2];
+    make_packet(left, right, data, 100, 0.0f);
+    pump.push_packet(data, 100);
+
+    EXPECT_EQ(pump.queued_frames(), 64u);
+    EXPECT_EQ(pump.frames_dropped(), 36u);
+}
+
+TEST(AudioPumpTest, StopFlushesRemainingSamples) {
+    SinkCapture capture;
+    AudioPump pump(capture.sink(), 60, 1);
+
+    pump.start();
+    pump.on_stream_started(48000, 2);
+
+    std::vector<float> left, right;
+    const float* data[2];
+    make_packet(left, right, data, 48, 1.0f);
+    pump.push_packet(data, 48);
+
+    pump.on_stream_stopped();
+    pump.stop();
+
+    // The drain loop's final pass delivers whatever capture queued
+    EXPECT_EQ(pump.frames_sent(), 48u);
+    EXPECT_EQ(pump.queued_frames(), 0u);
+}
+
+TEST(AudioPumpTest, AvOffsetTracksQueueDepth) {
+    SinkCapture capture;
+    AudioPump pump(capture.sink(), 60, 1);
+
+    pump.on_stream_started(48000, 2);
+    EXPECT_DOUBLE_EQ(pump.av_offset_ms(), 0.0);
+
+    std::vector<float> left, right;
+    const float* data[2];
+    make_packet(left, right, data, 480, 1.0f);  // 10 ms at 48 kHz
+    pump.push_packet(data, 480);
+    EXPECT_NEAR(pump.queued_ms(), 10.0, 0.01);
+
+    pump.start();
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::seconds(1);
+    while (capture.calls == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    pump.stop();
+
+    // EMA starts at zero and moves one step toward the 10 ms batch
+    EXPECT_GT(pump.av_offset_ms(), 0.0);
+    EXPECT_LE(pump.av_offset_ms(), 10.0);
+}
+
+TEST(AudioPumpTest, ConcurrentProducerNeverCorruptsStream) {
+    SinkCapture capture;
+    AudioPump pump(capture.sink(), 600, 1);  // Fast drain for the test
+
+    pump.on_stream_started(48000, 2);
+    pump.start();
+
+    // Producer pushes monotonically increasing samples from another thread
+    std::thread producer([&pump] {
+        std::vector<float> left, right;
+        const float* data[2];
+        for (int p = 0; p < 200; p++) {
+            make_packet(left, right, data, 64, static_cast<float>(p * 64));
+            pump.push_packet(data, 64);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+    producer.join();
+
+    pump.on_stream_stopped();
+    pump.stop();
+
+    EXPECT_EQ(pump.packets_received(), 200u);
+    EXPECT_EQ(pump.frames_sent() + pump.frames_dropped(), 200u * 64u);
+}
@@ -169,3 +169,179 @@ TEST_F(ConfigTest, StandardFramerates) {
     }
 }
 
+
+TEST_F(ConfigTest, ParseFramerateInteger) {
+    int num = 0, den = 0;
+    EXPECT_TRUE(Config::parse_framerate("60", num, den));
+    EXPECT_EQ(num, 60);
+    EXPECT_EQ(den, 1);
+}
+
+TEST_F(ConfigTest, ParseFramerateNtscDecimals) {
+    struct TestCase {
+        const char* str;
+        int num;
+        int den;
+    };
+    TestCase cases[] = {
+        {"59.94", 60000, 1001},
+        {"29.97", 30000, 1001},
+        {"23.976", 24000, 1001},
+        {"23.98", 24000, 1001},
+    };
+
+    for (const auto& tc : cases) {
+        int num = 0, den = 0;
+        EXPECT_TRUE(Config::parse_framerate(tc.str, num, den)) << tc.str;
+        EXPECT_EQ(num, tc.num) << tc.str;
+        EXPECT_EQ(den, tc.den) << tc.str;
+    }
+}
+
+TEST_F(ConfigTest, ParseFramerateExplicitRational) {
+    int num = 0, den = 0;
+    EXPECT_TRUE(Config::parse_framerate("60000/1001", num, den));
+    EXPECT_EQ(num, 60000);
+    EXPECT_EQ(den, 1001);
+}
+
+TEST_F(ConfigTest, ParseFramerateGenericDecimal) {
+    int num = 0, den = 0;
+    EXPECT_TRUE(Config::parse_framerate("12.5", num, den));
+    EXPECT_EQ(num, 25);
+    EXPECT_EQ(den, 2);
+}
+
+TEST_F(ConfigTest, ParseFramerateRejectsMalformed) {
+    int num = 0, den = 0;
+    EXPECT_FALSE(Config::parse_framerate("", num, den));
+    EXPECT_FALSE(Config::parse_framerate("abc", num, den));
+    EXPECT_FALSE(Config::parse_framerate("0", num, den));
+    EXPECT_FALSE(Config::parse_framerate("-30", num, den));
+    EXPECT_FALSE(Config::parse_framerate("60000/0", num, den));
+    EXPECT_FALSE(Config::parse_framerate("60/", num, den));
+    EXPECT_FALSE(Config::parse_framerate("59.94x", num, den));
+}
+
+TEST_F(ConfigTest, ParseFractionalFpsArg) {
+    const char* argv[] = {"html2ndi", "--url", "https://example.com", "--fps", "59.94"};
+    int argc = 5;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    ASSERT_TRUE(config.has_value());
+    EXPECT_EQ(config->fps_n, 60000);
+    EXPECT_EQ(config->fps_d, 1001);
+    EXPECT_EQ(config->fps, 60u);  // Rounded for integer consumers
+}
+
+TEST_F(ConfigTest, ParseStreamArgs) {
+    const char* argv[] = {"html2ndi", "--url", "https://example.com",
+                          "--stream", "Scoreboard,https://example.com/score",
+                          "--stream", "Clock,https://example.com/clock"};
+    int argc = 7;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    ASSERT_TRUE(config.has_value());
+    ASSERT_EQ(config->streams.size(), 2u);
+    EXPECT_EQ(config->streams[0].ndi_name, "Scoreboard");
+    EXPECT_EQ(config->streams[0].url, "https://example.com/score");
+    EXPECT_EQ(config->streams[1].ndi_name, "Clock");
+    EXPECT_EQ(config->streams[1].url, "https://example.com/clock");
+    EXPECT_TRUE(config->validate());
+}
+
+TEST_F(ConfigTest, ParseStreamRejectsMalformed) {
+    const char* argv[] = {"html2ndi", "--url", "https://example.com",
+                          "--stream", "NoCommaHere"};
+    int argc = 5;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    EXPECT_FALSE(config.has_value());
+}
+
+TEST_F(ConfigTest, ValidateRejectsDuplicateStreamNames) {
+    const char* argv[] = {"html2ndi", "--url", "https://example.com",
+                          "--stream", "Same,https://a.example",
+                          "--stream", "Same,https://b.example"};
+    int argc = 7;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    ASSERT_TRUE(config.has_value());
+    EXPECT_FALSE(config->validate());
+}
+
+TEST_F(ConfigTest, ParseAudioFlag) {
+    const char* argv[] = {"html2ndi", "--url", "https://example.com", "--audio"};
+    int argc = 4;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    ASSERT_TRUE(config.has_value());
+    EXPECT_TRUE(config->audio);
+    EXPECT_FALSE(Config().audio);  // Off by default
+}
+
+TEST_F(ConfigTest, ParsePrewarmFlag) {
+    const char* argv[] = {"html2ndi", "--prewarm"};
+    int argc = 2;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    ASSERT_TRUE(config.has_value());
+    EXPECT_TRUE(config->prewarm);
+    EXPECT_FALSE(Config().prewarm);  // Off by default
+}
+
+TEST_F(ConfigTest, ParsePatternFlag) {
+    const char* argv[] = {"html2ndi", "--pattern"};
+    int argc = 2;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    ASSERT_TRUE(config.has_value());
+    EXPECT_TRUE(config->test_pattern);
+    EXPECT_FALSE(Config().test_pattern);  // Off by default
+}
+
+TEST_F(ConfigTest, ParseProxyOptions) {
+    const char* argv[] = {"html2ndi", "--url", "https://example.com",
+                          "--proxy", "--proxy-width", "480",
+                          "--proxy-fps", "10"};
+    int argc = 8;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    ASSERT_TRUE(config.has_value());
+    EXPECT_TRUE(config->proxy);
+    EXPECT_EQ(config->proxy_width, 480u);
+    EXPECT_EQ(config->proxy_fps, 10u);
+    EXPECT_FALSE(Config().proxy);  // Off by default
+}
+
+TEST_F(ConfigTest, RejectsOutOfRangeProxyWidth) {
+    const char* argv[] = {"html2ndi", "--url", "https://example.com",
+                          "--proxy-width", "32"};
+    int argc = 5;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    EXPECT_FALSE(config.has_value());
+}
+
+TEST_F(ConfigTest, ParseThrottleOptions) {
+    const char* argv[] = {"html2ndi", "--url", "https://example.com",
+                          "--throttle", "tally", "--throttle-fps", "2"};
+    int argc = 7;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    ASSERT_TRUE(config.has_value());
+    EXPECT_EQ(config->throttle_mode, "tally");
+    EXPECT_EQ(config->throttle_fps, 2u);
+    EXPECT_TRUE(config->validate());
+    EXPECT_EQ(Config().throttle_mode, "off");  // Off by default
+}
+
+TEST_F(ConfigTest, RejectsUnknownThrottleMode) {
+    const char* argv[] = {"html2ndi", "--url", "https://example.com",
+                          "--throttle", "sometimes"};
+    int argc = 5;
+
+    auto config = Config::parse(argc, const_cast<char**>(argv));
+    ASSERT_TRUE(config.has_value());
+    EXPECT_FALSE(config->validate());
+}
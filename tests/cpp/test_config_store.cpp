@@ -0,0 +1,144 @@
+/**
+ * Unit tests for the hot-reloadable config store
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include "html2ndi/config_store.h"
+
+using namespace html2ndi;
+
+namespace {
+
+void write_file(const std::string& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::trunc);
+    file << contents;
+}
+
+// Wait for the watcher (500 ms mtime poll) to pick up a change
+bool wait_for_reload(const ConfigStore& store, uint64_t previous_count,
+                     int timeout_ms = 3000) {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (store.reload_count() > previous_count) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(ConfigStoreTest, SnapshotReflectsPublish) {
+    Config initial;
+    initial.url = "https://one.example";
+    ConfigStore store(initial);
+
+    auto first = store.snapshot();
+    EXPECT_EQ(first->url, "https://one.example");
+    EXPECT_EQ(store.generation(), 1u);
+
+    Config next = *first;
+    next.url = "https://two.example";
+    store.publish(next);
+
+    EXPECT_EQ(store.snapshot()->url, "https://two.example");
+    EXPECT_EQ(store.generation(), 2u);
+
+    // The old snapshot stays valid for readers that still hold it
+    EXPECT_EQ(first->url, "https://one.example");
+}
+
+TEST(ConfigStoreTest, ApplyJsonOverrides) {
+    Config config;
+    std::string error;
+
+    ASSERT_TRUE(ConfigStore::apply_json_overrides(
+        R"({"url": "https://cg.example", "idle_fps": 5, "log_level": 0})",
+        config, error));
+    EXPECT_EQ(config.url, "https://cg.example");
+    EXPECT_EQ(config.idle_fps, 5u);
+    EXPECT_EQ(config.log_level, 0);
+}
+
+TEST(ConfigStoreTest, ApplyJsonRejectsMalformed) {
+    Config config;
+    std::string error;
+
+    EXPECT_FALSE(ConfigStore::apply_json_overrides("{not json", config, error));
+    EXPECT_FALSE(error.empty());
+
+    EXPECT_FALSE(ConfigStore::apply_json_overrides("[1, 2]", config, error));
+    EXPECT_FALSE(ConfigStore::apply_json_overrides(
+        R"({"idle_fps": "fast"})", config, error));
+}
+
+TEST(ConfigStoreTest, ApplyJsonIgnoresColdKeys) {
+    Config config;
+    config.width = 1920;
+    std::string error;
+
+    // Geometry is not hot-reloadable; the key is ignored, not an error
+    ASSERT_TRUE(ConfigStore::apply_json_overrides(
+        R"({"width": 3840, "idle_fps": 2})", config, error));
+    EXPECT_EQ(config.width, 1920u);
+    EXPECT_EQ(config.idle_fps, 2u);
+}
+
+TEST(ConfigStoreTest, WatcherPublishesOnFileChange) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "html2ndi_test_config.json").string();
+    write_file(path, R"({"idle_fps": 1})");
+
+    Config initial;
+    ConfigStore store(initial);
+
+    std::atomic<int> callbacks{0};
+    store.set_change_callback(
+        [&callbacks](const Config&, const Config& current) {
+            EXPECT_EQ(current.idle_fps, 7u);
+            callbacks++;
+        });
+    ASSERT_TRUE(store.watch_file(path));
+
+    // Filesystem mtime granularity can be a full second
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    write_file(path, R"({"idle_fps": 7})");
+
+    ASSERT_TRUE(wait_for_reload(store, 0));
+    store.stop_watching();
+
+    EXPECT_EQ(store.snapshot()->idle_fps, 7u);
+    EXPECT_EQ(callbacks.load(), 1);
+    EXPECT_GE(store.generation(), 2u);
+
+    std::filesystem::remove(path);
+}
+
+TEST(ConfigStoreTest, BadEditKeepsLastGoodSnapshot) {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "html2ndi_test_config_bad.json").string();
+    write_file(path, R"({"idle_fps": 3})");
+
+    Config initial;
+    initial.idle_fps = 3;
+    ConfigStore store(initial);
+    ASSERT_TRUE(store.watch_file(path));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    write_file(path, "{broken");
+
+    // Give the watcher time to see (and reject) the edit
+    std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+    store.stop_watching();
+
+    EXPECT_EQ(store.reload_count(), 0u);
+    EXPECT_EQ(store.snapshot()->idle_fps, 3u);
+
+    std::filesystem::remove(path);
+}
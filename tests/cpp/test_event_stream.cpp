@@ -0,0 +1,140 @@
+/**
+ * Unit tests for the SSE fan-out hub behind GET /events
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "html2ndi/http/event_stream.h"
+
+using namespace html2ndi;
+using namespace std::chrono_literals;
+
+TEST(EventStreamTest, SubscribeDeliversHelloFrame) {
+    EventStream stream;
+    auto client = stream.subscribe();
+    EXPECT_EQ(stream.client_count(), 1u);
+
+    std::string frame;
+    ASSERT_TRUE(stream.next(*client, frame, 10ms));
+    EXPECT_EQ(frame, "event: hello\ndata: {\"connected\": true}\n\n");
+
+    stream.unsubscribe(client);
+    EXPECT_EQ(stream.client_count(), 0u);
+}
+
+TEST(EventStreamTest, PublishReachesAllSubscribers) {
+    EventStream stream;
+    auto a = stream.subscribe();
+    auto b = stream.subscribe();
+
+    stream.publish("tally", "{\"on_program\": true}");
+
+    std::string frame;
+    for (auto& client : {a, b}) {
+        ASSERT_TRUE(stream.next(*client, frame, 10ms));  // hello
+        ASSERT_TRUE(stream.next(*client, frame, 10ms));
+        EXPECT_EQ(frame, "event: tally\ndata: {\"on_program\": true}\n\n");
+    }
+    EXPECT_EQ(stream.events_published(), 1u);
+}
+
+TEST(EventStreamTest, NextTimesOutWhenQueueEmpty) {
+    EventStream stream;
+    auto client = stream.subscribe();
+
+    std::string frame;
+    ASSERT_TRUE(stream.next(*client, frame, 10ms));  // drain hello
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(stream.next(*client, frame, 20ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+}
+
+TEST(EventStreamTest, SlowClientDropsOldestNotNewest) {
+    EventStream stream;
+    auto client = stream.subscribe();
+
+    // hello + kQueueLimit events overflows the queue by exactly one
+    for (size_t i = 0; i < EventStream::kQueueLimit; ++i) {
+        stream.publish("status", "{\"seq\": " + std::to_string(i) + "}");
+    }
+
+    EXPECT_EQ(client->dropped, 1u);
+    EXPECT_EQ(stream.events_dropped(), 1u);
+
+    // The hello frame was the oldest, so seq 0 leads the queue now
+    std::string frame;
+    ASSERT_TRUE(stream.next(*client, frame, 10ms));
+    EXPECT_EQ(frame, "event: status\ndata: {\"seq\": 0}\n\n");
+
+    // The newest event survived at the back
+    while (stream.next(*client, frame, 0ms)) {
+    }
+    EXPECT_NE(frame.find("\"seq\": 63"), std::string::npos);
+}
+
+TEST(EventStreamTest, ShutdownWakesBlockedWaiters) {
+    EventStream stream;
+    auto client = stream.subscribe();
+
+    std::string frame;
+    ASSERT_TRUE(stream.next(*client, frame, 10ms));  // drain hello
+
+    std::thread waiter([&] {
+        std::string out;
+        EXPECT_FALSE(stream.next(*client, out, 5s));
+    });
+
+    std::this_thread::sleep_for(20ms);
+    const auto start = std::chrono::steady_clock::now();
+    stream.shutdown();
+    waiter.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+    EXPECT_EQ(stream.client_count(), 0u);
+}
+
+TEST(EventStreamTest, PublishAfterUnsubscribeIsSafe) {
+    EventStream stream;
+    auto client = stream.subscribe();
+    stream.unsubscribe(client);
+
+    stream.publish("status", "{}");
+
+    std::string frame;
+    ASSERT_TRUE(stream.next(*client, frame, 0ms));  // hello still queued
+    EXPECT_FALSE(stream.next(*client, frame, 0ms));
+}
+
+TEST(EventStreamTest, ConcurrentPublishersStayConsistent) {
+    EventStream stream;
+    auto client = stream.subscribe();
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 200;
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < kThreads; ++t) {
+        publishers.emplace_back([&stream] {
+            for (int i = 0; i < kPerThread; ++i) {
+                stream.publish("status", "{\"n\": 1}");
+            }
+        });
+    }
+    for (auto& thread : publishers) {
+        thread.join();
+    }
+
+    EXPECT_EQ(stream.events_published(),
+              static_cast<uint64_t>(kThreads) * kPerThread);
+
+    // Every event was either delivered or counted as dropped
+    uint64_t drained = 0;
+    std::string frame;
+    while (stream.next(*client, frame, 0ms)) {
+        drained++;
+    }
+    EXPECT_EQ(drained + stream.events_dropped(),
+              static_cast<uint64_t>(kThreads) * kPerThread + 1);  // +hello
+}
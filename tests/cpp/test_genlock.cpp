@@ -253,3 +253,63 @@ TEST_F(GenlockTest, AddressParsing) {
     SUCCEED();
 }
 
+
+// Test that a phase offset shifts the send slot within the frame interval
+TEST_F(GenlockTest, PhaseOffsetShiftsSendSlot) {
+    GenlockClock aligned(GenlockMode::Master, "127.0.0.1:5970", test_fps_);
+    EXPECT_TRUE(aligned.initialize());
+
+    GenlockClock shifted(GenlockMode::Master, "127.0.0.1:5971", test_fps_);
+    EXPECT_TRUE(shifted.initialize());
+    shifted.set_phase_offset_us(4000);
+    EXPECT_EQ(shifted.phase_offset_us(), 4000);
+
+    auto frame_duration = std::chrono::nanoseconds(1'000'000'000 / test_fps_);
+    auto current_time = shifted.now();
+
+    // The shifted boundary lands phase_us after some aligned boundary,
+    // modulo the frame interval
+    auto boundary = shifted.next_frame_boundary(current_time, frame_duration);
+    EXPECT_GT(boundary, current_time);
+    EXPECT_LE(boundary - current_time, frame_duration);
+
+    // Consecutive boundaries stay exactly one frame apart on the shifted
+    // timeline
+    auto following = shifted.next_frame_boundary(boundary, frame_duration);
+    auto gap = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        following - boundary).count();
+    EXPECT_EQ(gap, frame_duration.count());
+}
+
+// Test that the phase offset folds into one frame interval
+TEST_F(GenlockTest, PhaseOffsetFoldsIntoFrame) {
+    GenlockClock clock(GenlockMode::Master, "127.0.0.1:5972", test_fps_);
+    EXPECT_TRUE(clock.initialize());
+
+    // 60 fps frame = 16667 us; an offset over a frame folds back down
+    clock.set_phase_offset_us(20000);
+
+    auto frame_duration = std::chrono::nanoseconds(1'000'000'000 / test_fps_);
+    auto current_time = clock.now();
+    auto boundary = clock.next_frame_boundary(current_time, frame_duration);
+
+    EXPECT_GT(boundary, current_time);
+    EXPECT_LE(boundary - current_time, frame_duration);
+}
+
+// Test that the phase offset does not move the stamped timecode timeline
+TEST_F(GenlockTest, PhaseOffsetKeepsTimecodeAligned) {
+    GenlockClock clock(GenlockMode::Master, "127.0.0.1:5973", test_fps_);
+    EXPECT_TRUE(clock.initialize());
+
+    int64_t before = clock.get_ndi_timecode();
+    clock.set_phase_offset_us(8000);
+    int64_t after = clock.get_ndi_timecode();
+
+    // Timecode is stamped against the un-shifted boundary: the 8000 us
+    // offset must be subtracted back out (80000 units of 100 ns), leaving
+    // only the few real microseconds between the two calls
+    int64_t delta_100ns = after - before + 80000;
+    EXPECT_GE(delta_100ns, 0);
+    EXPECT_LT(delta_100ns, 50000);  // < 5 ms of real elapsed time
+}
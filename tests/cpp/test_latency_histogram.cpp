@@ -0,0 +1,108 @@
+/**
+ * Unit tests for the log-bucketed latency histogram
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "html2ndi/utils/latency_histogram.h"
+
+using namespace html2ndi;
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.count(), 0u);
+    EXPECT_EQ(h.max(), 0u);
+    EXPECT_DOUBLE_EQ(h.mean(), 0.0);
+    EXPECT_EQ(h.percentile(50.0), 0u);
+    EXPECT_EQ(h.percentile(99.9), 0u);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram h;
+    for (uint64_t v = 0; v < LatencyHistogram::kSubBuckets; v++) {
+        h.record(v);
+    }
+    EXPECT_EQ(h.count(), 16u);
+    EXPECT_EQ(h.percentile(100.0), 15u);
+    EXPECT_EQ(h.max(), 15u);
+}
+
+TEST(LatencyHistogramTest, PercentilesBoundTheSample) {
+    LatencyHistogram h;
+    for (int i = 0; i < 1000; i++) {
+        h.record(180);
+    }
+
+    // The bucket upper bound never under-states latency, and the 6%
+    // resolution keeps it close
+    EXPECT_GE(h.percentile(50.0), 180u);
+    EXPECT_LE(h.percentile(50.0), 200u);
+    EXPECT_GE(h.percentile(99.9), 180u);
+    EXPECT_EQ(h.max(), 180u);
+    EXPECT_DOUBLE_EQ(h.mean(), 180.0);
+}
+
+TEST(LatencyHistogramTest, TailSpikeSurvivesTheAverage) {
+    // The motivating case: 10k submits at 180 us with a handful of 3 ms
+    // spikes. The mean barely moves but p999 and max must show the spike.
+    LatencyHistogram h;
+    for (int i = 0; i < 10000; i++) {
+        h.record(180);
+    }
+    for (int i = 0; i < 20; i++) {
+        h.record(3000);
+    }
+
+    EXPECT_LT(h.mean(), 200.0);
+    EXPECT_GE(h.percentile(99.9), 2800u);
+    EXPECT_EQ(h.max(), 3000u);
+
+    const auto s = h.summary();
+    EXPECT_EQ(s.count, 10020u);
+    EXPECT_GE(s.p999, 2800u);
+    EXPECT_EQ(s.max, 3000u);
+}
+
+TEST(LatencyHistogramTest, HugeValuesClampInsteadOfOverflowing) {
+    LatencyHistogram h;
+    h.record(uint64_t{1} << 40);  // Way past the tracked range
+    EXPECT_EQ(h.count(), 1u);
+    EXPECT_EQ(h.max(), uint64_t{1} << 40);
+    EXPECT_GE(h.percentile(100.0), (uint64_t{1} << 30) - (uint64_t{1} << 26));
+}
+
+TEST(LatencyHistogramTest, ResetZerosEverything) {
+    LatencyHistogram h;
+    for (int i = 0; i < 100; i++) {
+        h.record(500);
+    }
+    h.reset();
+
+    EXPECT_EQ(h.count(), 0u);
+    EXPECT_EQ(h.max(), 0u);
+    EXPECT_EQ(h.percentile(99.0), 0u);
+    EXPECT_DOUBLE_EQ(h.mean(), 0.0);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordersLoseNothing) {
+    LatencyHistogram h;
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 10000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&h, t] {
+            for (int i = 0; i < kPerThread; i++) {
+                h.record(static_cast<uint64_t>(100 + t));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(h.count(), static_cast<uint64_t>(kThreads) * kPerThread);
+    EXPECT_EQ(h.max(), 103u);
+}
@@ -112,3 +112,42 @@ TEST_F(LoggerTest, GetDefaultLogDirectory) {
     EXPECT_TRUE(log_dir.find("Library/Logs/HTML2NDI") != std::string::npos);
 }
 
+
+TEST_F(LoggerTest, AsyncModeDeliversRecords) {
+    Logger::instance().initialize(LogLevel::INFO, test_log_path);
+    Logger::instance().set_async(true);
+
+    Logger::instance().log(LogLevel::INFO, "Async record %d", 42);
+    Logger::instance().flush();
+    Logger::instance().set_async(false);
+
+    std::ifstream file(test_log_path);
+    ASSERT_TRUE(file.is_open());
+    std::string content((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+    EXPECT_TRUE(content.find("Async record 42") != std::string::npos);
+    EXPECT_FALSE(Logger::instance().async_enabled());
+}
+
+TEST_F(LoggerTest, AsyncModeThreadSafety) {
+    Logger::instance().initialize(LogLevel::INFO, test_log_path);
+    Logger::instance().set_async(true);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([i]() {
+            for (int j = 0; j < 200; ++j) {
+                Logger::instance().log(LogLevel::INFO, "Async thread %d message %d", i, j);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    Logger::instance().flush();
+    Logger::instance().set_async(false);
+
+    // Everything that was not counted as dropped must have been written
+    EXPECT_TRUE(std::filesystem::exists(test_log_path));
+}
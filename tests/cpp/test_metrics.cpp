@@ -0,0 +1,79 @@
+/**
+ * Unit tests for the metrics registry
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include "html2ndi/utils/metrics.h"
+
+using namespace html2ndi;
+
+// The registry is a process-wide singleton, so each test uses its own
+// metric names and unregisters them on the way out.
+
+TEST(MetricsRegistryTest, RendersCounterAndGauge) {
+    auto& registry = MetricsRegistry::instance();
+    std::atomic<uint64_t> frames{42};
+
+    registry.register_metric("test_frames_total", "Test frame counter",
+                             MetricsRegistry::Type::Counter,
+                             [&frames] { return static_cast<double>(frames.load()); });
+    registry.register_metric("test_fps", "Test fps gauge",
+                             MetricsRegistry::Type::Gauge,
+                             [] { return 29.97; });
+
+    std::string out = registry.render();
+    EXPECT_NE(out.find("# HELP test_frames_total Test frame counter\n"), std::string::npos);
+    EXPECT_NE(out.find("# TYPE test_frames_total counter\n"), std::string::npos);
+    EXPECT_NE(out.find("test_frames_total 42\n"), std::string::npos);
+    EXPECT_NE(out.find("# TYPE test_fps gauge\n"), std::string::npos);
+    EXPECT_NE(out.find("test_fps 29.97\n"), std::string::npos);
+
+    registry.unregister_metric("test_frames_total");
+    registry.unregister_metric("test_fps");
+}
+
+TEST(MetricsRegistryTest, SamplersReadCurrentValue) {
+    auto& registry = MetricsRegistry::instance();
+    std::atomic<uint64_t> counter{0};
+
+    registry.register_metric("test_live_total", "Live counter",
+                             MetricsRegistry::Type::Counter,
+                             [&counter] { return static_cast<double>(counter.load()); });
+
+    counter = 7;
+    EXPECT_NE(registry.render().find("test_live_total 7\n"), std::string::npos);
+    counter = 8;
+    EXPECT_NE(registry.render().find("test_live_total 8\n"), std::string::npos);
+
+    registry.unregister_metric("test_live_total");
+}
+
+TEST(MetricsRegistryTest, ReRegisteringReplacesSampler) {
+    auto& registry = MetricsRegistry::instance();
+
+    registry.register_metric("test_replace", "First", MetricsRegistry::Type::Gauge,
+                             [] { return 1.0; });
+    registry.register_metric("test_replace", "Second", MetricsRegistry::Type::Gauge,
+                             [] { return 2.0; });
+
+    std::string out = registry.render();
+    EXPECT_EQ(out.find("test_replace 1\n"), std::string::npos);
+    EXPECT_NE(out.find("# HELP test_replace Second\n"), std::string::npos);
+    EXPECT_NE(out.find("test_replace 2\n"), std::string::npos);
+
+    registry.unregister_metric("test_replace");
+}
+
+TEST(MetricsRegistryTest, UnregisterRemovesMetric) {
+    auto& registry = MetricsRegistry::instance();
+
+    registry.register_metric("test_gone", "Goes away", MetricsRegistry::Type::Gauge,
+                             [] { return 5.0; });
+    registry.unregister_metric("test_gone");
+
+    EXPECT_EQ(registry.render().find("test_gone"), std::string::npos);
+
+    // Unregistering a name that is not registered is a no-op
+    registry.unregister_metric("test_gone");
+}
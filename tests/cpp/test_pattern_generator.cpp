@@ -0,0 +1,159 @@
+/**
+ * Unit tests for the procedural test-pattern generator (--pattern mode)
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "html2ndi/ndi/pattern_generator.h"
+
+using namespace html2ndi;
+
+namespace {
+
+// Captures submitted frames the way FramePump::submit_frame would
+struct FrameCapture {
+    std::vector<uint8_t> pixels;
+    int width{0};
+    int height{0};
+    FrameRectList dirty;
+    int calls{0};
+
+    PatternGenerator::SubmitCallback sink() {
+        return [this](const void* buffer, int w, int h,
+                      const FrameRectList& rects) {
+            width = w;
+            height = h;
+            const auto* bytes = static_cast<const uint8_t*>(buffer);
+            pixels.assign(bytes, bytes + static_cast<size_t>(w) * h * 4);
+            dirty = rects;
+            calls++;
+        };
+    }
+};
+
+} // namespace
+
+TEST(PatternGeneratorTest, SubmitsFullFramesAtTargetGeometry) {
+    FrameCapture capture;
+    PatternGenerator gen(320, 180, 30, 1, capture.sink());
+
+    gen.generate_frame();
+
+    EXPECT_EQ(capture.calls, 1);
+    EXPECT_EQ(capture.width, 320);
+    EXPECT_EQ(capture.height, 180);
+    EXPECT_EQ(capture.pixels.size(), 320u * 180u * 4u);
+    ASSERT_EQ(capture.dirty.size(), 1u);
+    EXPECT_EQ(capture.dirty[0].width, 320);
+    EXPECT_EQ(capture.dirty[0].height, 180);
+    EXPECT_EQ(gen.frames_generated(), 1u);
+}
+
+TEST(PatternGeneratorTest, TopBandIsColorBars) {
+    FrameCapture capture;
+    PatternGenerator gen(320, 180, 30, 1, capture.sink());
+
+    gen.generate_frame();
+
+    // 8 bars of 40 px each; sample the middle of the first (white) and
+    // last (black) bars in BGRA
+    const uint8_t* row = capture.pixels.data();
+    const uint8_t* white = row + 20 * 4;
+    EXPECT_EQ(white[0], 191);
+    EXPECT_EQ(white[1], 191);
+    EXPECT_EQ(white[2], 191);
+    EXPECT_EQ(white[3], 255);
+
+    const uint8_t* black = row + (320 - 20) * 4;
+    EXPECT_EQ(black[0], 0);
+    EXPECT_EQ(black[1], 0);
+    EXPECT_EQ(black[2], 0);
+    EXPECT_EQ(black[3], 255);
+}
+
+TEST(PatternGeneratorTest, EveryPixelIsOpaque) {
+    FrameCapture capture;
+    PatternGenerator gen(128, 128, 30, 1, capture.sink());
+
+    gen.generate_frame();
+
+    for (size_t i = 3; i < capture.pixels.size(); i += 4) {
+        ASSERT_EQ(capture.pixels[i], 255) << "at byte " << i;
+    }
+}
+
+TEST(PatternGeneratorTest, ZonePlateMovesBetweenFrames) {
+    FrameCapture capture;
+    PatternGenerator gen(320, 180, 30, 1, capture.sink());
+
+    gen.generate_frame();
+    std::vector<uint8_t> first = capture.pixels;
+    gen.generate_frame();
+
+    // Compare the zone plate band (rows 108..147 for 180p): the phase
+    // advances per frame, so consecutive frames must differ there
+    size_t row_bytes = 320 * 4;
+    size_t band_start = 110 * row_bytes;
+    size_t band_len = 30 * row_bytes;
+    EXPECT_NE(0, std::memcmp(first.data() + band_start,
+                             capture.pixels.data() + band_start, band_len));
+}
+
+TEST(PatternGeneratorTest, CounterBurnInChangesEachFrame) {
+    FrameCapture capture;
+    PatternGenerator gen(320, 180, 30, 1, capture.sink());
+
+    gen.generate_frame();
+    std::vector<uint8_t> first = capture.pixels;
+    gen.generate_frame();
+
+    // Bottom 32-row strip holds the frame counter and motion block
+    size_t row_bytes = 320 * 4;
+    size_t strip_start = (180 - 32) * row_bytes;
+    EXPECT_NE(0, std::memcmp(first.data() + strip_start,
+                             capture.pixels.data() + strip_start,
+                             capture.pixels.size() - strip_start));
+}
+
+TEST(PatternGeneratorTest, TinyFramesDoNotCrash) {
+    FrameCapture capture;
+    PatternGenerator gen(16, 16, 30, 1, capture.sink());
+
+    gen.generate_frame();
+    gen.generate_frame();
+
+    EXPECT_EQ(capture.calls, 2);
+    EXPECT_EQ(capture.pixels.size(), 16u * 16u * 4u);
+}
+
+TEST(PatternGeneratorTest, CounterStaysInsideNarrowFrames) {
+    // Ten digits need 40*scale columns; the scale must shrink with the
+    // width so a 128-wide frame does not bleed digit pixels into the
+    // following rows
+    for (int width : {40, 64, 128, 159}) {
+        FrameCapture capture;
+        PatternGenerator gen(width, 270, 30, 1, capture.sink());
+        gen.generate_frame();
+        gen.generate_frame();
+
+        int plate_bottom = std::max(270 * 3 / 5, 270 - 32);
+        int strip_height = 270 - plate_bottom;
+        int scale = std::min({4, strip_height / 7, width / 40});
+        int limit = 40 * scale;
+        bool any_lit = false;
+        for (int y = plate_bottom; y < 270; y++) {
+            for (int x = 0; x < width; x++) {
+                size_t i = (static_cast<size_t>(y) * width + x) * 4;
+                if (capture.pixels[i] != 0) {
+                    any_lit = true;
+                    EXPECT_LT(x, limit) << "width " << width << " row " << y;
+                }
+            }
+        }
+        EXPECT_TRUE(any_lit) << "width " << width;
+    }
+}
@@ -0,0 +1,290 @@
+/**
+ * Unit tests for pixel format conversion kernels.
+ */
+
+#include <gtest/gtest.h>
+#include "html2ndi/ndi/pixel_convert.h"
+
+#include <vector>
+
+using namespace html2ndi;
+
+namespace {
+
+// Fill a BGRA buffer with a single color
+std::vector<uint8_t> solid_bgra(int width, int height,
+                                uint8_t r, uint8_t g, uint8_t b) {
+    std::vector<uint8_t> data(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < data.size(); i += 4) {
+        data[i + 0] = b;
+        data[i + 1] = g;
+        data[i + 2] = r;
+        data[i + 3] = 255;
+    }
+    return data;
+}
+
+} // anonymous namespace
+
+class PixelConvertTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(PixelConvertTest, CoefficientsLuminanceSumsToPeak) {
+    // White must map to peak luma: 235 limited, 255 full
+    auto limited = uyvy_coefficients(ColorSpace::Rec709, ColorRange::Limited);
+    EXPECT_EQ(limited.yr + limited.yg + limited.yb, 220);  // 256 * 219/255
+    EXPECT_EQ(limited.y_offset, 16);
+
+    auto full = uyvy_coefficients(ColorSpace::Rec709, ColorRange::Full);
+    EXPECT_EQ(full.yr + full.yg + full.yb, 256);
+    EXPECT_EQ(full.y_offset, 0);
+}
+
+TEST_F(PixelConvertTest, WhiteConvertsToPeakLumaNeutralChroma) {
+    const int width = 64, height = 4;
+    auto bgra = solid_bgra(width, height, 255, 255, 255);
+    std::vector<uint8_t> uyvy(static_cast<size_t>(width) * height * 2);
+
+    bgra_to_uyvy(bgra.data(), width, height,
+                 ColorSpace::Rec709, ColorRange::Limited, uyvy.data());
+
+    for (size_t i = 0; i < uyvy.size(); i += 4) {
+        EXPECT_NEAR(uyvy[i + 0], 128, 1);  // U
+        EXPECT_NEAR(uyvy[i + 1], 235, 1);  // Y0
+        EXPECT_NEAR(uyvy[i + 2], 128, 1);  // V
+        EXPECT_NEAR(uyvy[i + 3], 235, 1);  // Y1
+    }
+}
+
+TEST_F(PixelConvertTest, BlackConvertsToSetupLevel) {
+    const int width = 32, height = 2;
+    auto bgra = solid_bgra(width, height, 0, 0, 0);
+    std::vector<uint8_t> uyvy(static_cast<size_t>(width) * height * 2);
+
+    bgra_to_uyvy(bgra.data(), width, height,
+                 ColorSpace::Rec709, ColorRange::Limited, uyvy.data());
+
+    for (size_t i = 0; i < uyvy.size(); i += 4) {
+        EXPECT_NEAR(uyvy[i + 0], 128, 1);
+        EXPECT_NEAR(uyvy[i + 1], 16, 1);
+        EXPECT_NEAR(uyvy[i + 2], 128, 1);
+        EXPECT_NEAR(uyvy[i + 3], 16, 1);
+    }
+}
+
+TEST_F(PixelConvertTest, RedMatchesReferenceBT601) {
+    // BT.601 limited: pure red is approximately Y=81, U=90, V=240
+    const int width = 16, height = 1;
+    auto bgra = solid_bgra(width, height, 255, 0, 0);
+    std::vector<uint8_t> uyvy(static_cast<size_t>(width) * height * 2);
+
+    bgra_to_uyvy(bgra.data(), width, height,
+                 ColorSpace::Rec601, ColorRange::Limited, uyvy.data());
+
+    EXPECT_NEAR(uyvy[1], 81, 2);   // Y
+    EXPECT_NEAR(uyvy[0], 90, 2);   // U
+    EXPECT_NEAR(uyvy[2], 240, 2);  // V
+}
+
+TEST_F(PixelConvertTest, VectorAndScalarPathsAgree) {
+    // Width 37 exercises the NEON main loop, the scalar tail, and the odd
+    // trailing pixel; a gradient catches lane-ordering mistakes
+    const int width = 37, height = 3;
+    std::vector<uint8_t> bgra(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            size_t i = (static_cast<size_t>(y) * width + x) * 4;
+            bgra[i + 0] = static_cast<uint8_t>(x * 7);        // B
+            bgra[i + 1] = static_cast<uint8_t>(255 - x * 5);  // G
+            bgra[i + 2] = static_cast<uint8_t>(y * 50 + x);   // R
+            bgra[i + 3] = 255;
+        }
+    }
+
+    std::vector<uint8_t> uyvy(static_cast<size_t>(width) * height * 2, 0);
+    bgra_to_uyvy(bgra.data(), width, height,
+                 ColorSpace::Rec709, ColorRange::Full, uyvy.data());
+
+    // Spot-check luma monotonicity against the scalar formula
+    auto c = uyvy_coefficients(ColorSpace::Rec709, ColorRange::Full);
+    for (int x = 0; x < width - 1; x += 2) {
+        size_t src = static_cast<size_t>(x) * 4;
+        int expected = ((c.yr * bgra[src + 2] + c.yg * bgra[src + 1] +
+                         c.yb * bgra[src + 0] + 128) >> 8) + c.y_offset;
+        EXPECT_NEAR(uyvy[x * 2 + 1], expected, 1) << "pixel " << x;
+    }
+}
+
+TEST_F(PixelConvertTest, PremultiplyMatchesRoundedProduct) {
+    // Width 19 exercises the NEON main loop plus the scalar tail
+    const int width = 19, height = 2;
+    std::vector<uint8_t> bgra(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < bgra.size(); i += 4) {
+        bgra[i + 0] = static_cast<uint8_t>(i * 3);
+        bgra[i + 1] = static_cast<uint8_t>(255 - i);
+        bgra[i + 2] = static_cast<uint8_t>(i * 7);
+        bgra[i + 3] = static_cast<uint8_t>(i);
+    }
+
+    std::vector<uint8_t> out(bgra.size(), 0);
+    bgra_premultiply(bgra.data(), width, height, out.data());
+
+    for (size_t i = 0; i < bgra.size(); i += 4) {
+        const int a = bgra[i + 3];
+        for (int c = 0; c < 3; c++) {
+            int expected = (bgra[i + c] * a + 127) / 255;
+            EXPECT_NEAR(out[i + c], expected, 1) << "byte " << (i + c);
+        }
+        EXPECT_EQ(out[i + 3], a) << "alpha must pass through";
+    }
+}
+
+TEST_F(PixelConvertTest, UnpremultiplyInvertsPremultiply) {
+    const int width = 16, height = 1;
+    std::vector<uint8_t> bgra(static_cast<size_t>(width) * height * 4);
+    for (int x = 0; x < width; x++) {
+        size_t i = static_cast<size_t>(x) * 4;
+        bgra[i + 0] = static_cast<uint8_t>(x * 16);
+        bgra[i + 1] = static_cast<uint8_t>(200 - x * 4);
+        bgra[i + 2] = static_cast<uint8_t>(40 + x * 9);
+        bgra[i + 3] = static_cast<uint8_t>(128 + x * 8);  // Alpha >= 128
+    }
+
+    std::vector<uint8_t> pre(bgra.size(), 0);
+    std::vector<uint8_t> back(bgra.size(), 0);
+    bgra_premultiply(bgra.data(), width, height, pre.data());
+    bgra_unpremultiply(pre.data(), width, height, back.data());
+
+    // Quantization costs at most one code value when alpha >= 128
+    for (size_t i = 0; i < bgra.size(); i++) {
+        EXPECT_NEAR(back[i], bgra[i], 1) << "byte " << i;
+    }
+}
+
+TEST_F(PixelConvertTest, UnpremultiplyZeroAlphaYieldsZero) {
+    uint8_t bgra[4] = {90, 120, 200, 0};
+    uint8_t out[4] = {255, 255, 255, 255};
+    bgra_unpremultiply(bgra, 1, 1, out);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[1], 0);
+    EXPECT_EQ(out[2], 0);
+    EXPECT_EQ(out[3], 0);
+}
+
+TEST_F(PixelConvertTest, ExtractFieldSplitsEvenAndOddRows) {
+    const int width = 4, height = 6;
+    std::vector<uint8_t> bgra(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (size_t i = 0; i < static_cast<size_t>(width) * 4; i++) {
+            bgra[static_cast<size_t>(y) * width * 4 + i] = static_cast<uint8_t>(y);
+        }
+    }
+
+    std::vector<uint8_t> top(static_cast<size_t>(width) * 3 * 4, 0xFF);
+    std::vector<uint8_t> bottom(static_cast<size_t>(width) * 3 * 4, 0xFF);
+    bgra_extract_field(bgra.data(), width, height, true, top.data());
+    bgra_extract_field(bgra.data(), width, height, false, bottom.data());
+
+    for (int row = 0; row < 3; row++) {
+        for (size_t i = 0; i < static_cast<size_t>(width) * 4; i++) {
+            EXPECT_EQ(top[static_cast<size_t>(row) * width * 4 + i], row * 2)
+                << "top field row " << row;
+            EXPECT_EQ(bottom[static_cast<size_t>(row) * width * 4 + i], row * 2 + 1)
+                << "bottom field row " << row;
+        }
+    }
+}
+
+TEST_F(PixelConvertTest, ExtractFieldOddHeightGivesTopTheExtraRow) {
+    const int width = 2, height = 5;
+    std::vector<uint8_t> bgra(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (size_t i = 0; i < static_cast<size_t>(width) * 4; i++) {
+            bgra[static_cast<size_t>(y) * width * 4 + i] = static_cast<uint8_t>(y);
+        }
+    }
+
+    // Top field holds rows 0, 2, 4; bottom holds rows 1, 3
+    std::vector<uint8_t> top(static_cast<size_t>(width) * 3 * 4, 0xFF);
+    std::vector<uint8_t> bottom(static_cast<size_t>(width) * 2 * 4, 0xFF);
+    bgra_extract_field(bgra.data(), width, height, true, top.data());
+    bgra_extract_field(bgra.data(), width, height, false, bottom.data());
+
+    EXPECT_EQ(top[static_cast<size_t>(2) * width * 4], 4);
+    EXPECT_EQ(bottom[static_cast<size_t>(1) * width * 4], 3);
+}
+
+TEST_F(PixelConvertTest, FullToLimitedMapsEndpointsOnto16To235) {
+    const int width = 32, height = 1;  // Covers NEON lanes and scalar tail
+    std::vector<uint8_t> bgra(static_cast<size_t>(width) * height * 4);
+    for (int x = 0; x < width; x++) {
+        size_t i = static_cast<size_t>(x) * 4;
+        bgra[i + 0] = static_cast<uint8_t>(x * 8);
+        bgra[i + 1] = 0;
+        bgra[i + 2] = 255;
+        bgra[i + 3] = static_cast<uint8_t>(x);
+    }
+
+    std::vector<uint8_t> out(bgra.size(), 0);
+    bgra_full_to_limited(bgra.data(), width, height, out.data());
+
+    for (int x = 0; x < width; x++) {
+        size_t i = static_cast<size_t>(x) * 4;
+        int expected = 16 + (bgra[i] * 219 + 127) / 255;
+        EXPECT_NEAR(out[i + 0], expected, 1) << "pixel " << x;
+        EXPECT_EQ(out[i + 1], 16) << "black maps to setup level";
+        EXPECT_EQ(out[i + 2], 235) << "peak maps to 235";
+        EXPECT_EQ(out[i + 3], x) << "alpha must pass through";
+    }
+}
+
+TEST_F(PixelConvertTest, LimitedToFullInvertsWithinOneCode) {
+    const int width = 24, height = 1;
+    std::vector<uint8_t> bgra(static_cast<size_t>(width) * height * 4);
+    for (int x = 0; x < width; x++) {
+        size_t i = static_cast<size_t>(x) * 4;
+        bgra[i + 0] = static_cast<uint8_t>(x * 11);
+        bgra[i + 1] = static_cast<uint8_t>(255 - x * 10);
+        bgra[i + 2] = static_cast<uint8_t>(128 + x * 5);
+        bgra[i + 3] = 255;
+    }
+
+    std::vector<uint8_t> limited(bgra.size(), 0);
+    std::vector<uint8_t> back(bgra.size(), 0);
+    bgra_full_to_limited(bgra.data(), width, height, limited.data());
+    bgra_limited_to_full(limited.data(), width, height, back.data());
+
+    // Two quantizing passes cost at most two code values
+    for (size_t i = 0; i < bgra.size(); i++) {
+        EXPECT_NEAR(back[i], bgra[i], 2) << "byte " << i;
+    }
+}
+
+TEST_F(PixelConvertTest, LimitedToFullClampsOutOfRangeInput) {
+    // Sub-black and super-white inputs clamp instead of wrapping
+    uint8_t bgra[8] = {5, 10, 15, 200, 240, 250, 255, 100};
+    uint8_t out[8];
+    bgra_limited_to_full(bgra, 2, 1, out);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[1], 0);
+    EXPECT_EQ(out[2], 0);
+    EXPECT_EQ(out[3], 200);
+    EXPECT_EQ(out[4], 255);
+    EXPECT_EQ(out[5], 255);
+    EXPECT_EQ(out[6], 255);
+    EXPECT_EQ(out[7], 100);
+}
+
+TEST_F(PixelConvertTest, FullToLimitedSupportsInPlace) {
+    std::vector<uint8_t> bgra(64 * 4);
+    for (size_t i = 0; i < bgra.size(); i++) {
+        bgra[i] = static_cast<uint8_t>(i);
+    }
+    std::vector<uint8_t> reference(bgra.size(), 0);
+    bgra_full_to_limited(bgra.data(), 64, 1, reference.data());
+    bgra_full_to_limited(bgra.data(), 64, 1, bgra.data());
+    EXPECT_EQ(bgra, reference);
+}
@@ -0,0 +1,183 @@
+/**
+ * Unit tests for the shared-memory preview publisher
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "html2ndi/utils/shm_preview.h"
+
+using namespace html2ndi;
+
+namespace {
+
+// Each test gets its own segment name so runs never collide
+std::string unique_segment_name(const char* tag) {
+    return std::string("/html2ndi.test.") + tag + "." + std::to_string(getpid());
+}
+
+// Map an existing segment read-only, the way a supervisor would
+struct ReaderMapping {
+    const ShmPreview::Header* header{nullptr};
+    const uint8_t* pixels{nullptr};
+    void* mem{MAP_FAILED};
+    size_t size{0};
+    int fd{-1};
+
+    bool open(const std::string& name, size_t mapped_size) {
+        fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+        size = mapped_size;
+        mem = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (mem == MAP_FAILED) {
+            return false;
+        }
+        header = static_cast<const ShmPreview::Header*>(mem);
+        pixels = static_cast<const uint8_t*>(mem) + sizeof(ShmPreview::Header);
+        return true;
+    }
+
+    ~ReaderMapping() {
+        if (mem != MAP_FAILED) {
+            munmap(mem, size);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+// Wait until the publisher has written at least one frame
+bool wait_for_publish(const ShmPreview& preview, int timeout_ms = 2000) {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(timeout_ms);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (preview.frames_published() > 0) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(ShmPreviewTest, InitializeWritesHeader) {
+    const std::string name = unique_segment_name("header");
+    ShmPreview preview(name, 64, 30,
+                       [](std::vector<uint8_t>&, int&, int&) { return false; },
+                       [] { return 0ULL; });
+    ASSERT_TRUE(preview.initialize());
+
+    ReaderMapping reader;
+    ASSERT_TRUE(reader.open(name, sizeof(ShmPreview::Header) + 64 * 64 * 4));
+    EXPECT_EQ(reader.header->magic, ShmPreview::kMagic);
+    EXPECT_EQ(reader.header->version, ShmPreview::kVersion);
+    EXPECT_EQ(reader.header->frame_number, 0u);
+
+    preview.shutdown();
+}
+
+TEST(ShmPreviewTest, PublishesFrameWithConsistentSeqlock) {
+    const std::string name = unique_segment_name("publish");
+    const int width = 16, height = 8;
+
+    // Solid-color source frame at the preview width (no downscale path)
+    ShmPreview preview(name, 16, 60,
+                       [](std::vector<uint8_t>& data, int& w, int& h) {
+                           w = width;
+                           h = height;
+                           data.assign(static_cast<size_t>(width) * height * 4, 0xAB);
+                           return true;
+                       },
+                       [] { return 1ULL; });
+    ASSERT_TRUE(preview.initialize());
+
+    ReaderMapping reader;
+    ASSERT_TRUE(reader.open(name, sizeof(ShmPreview::Header) + 16 * 16 * 4));
+
+    preview.start();
+    ASSERT_TRUE(wait_for_publish(preview));
+    preview.stop();
+
+    // Sequence is even once the writer is quiescent
+    EXPECT_EQ(reader.header->sequence.load() % 2, 0u);
+    EXPECT_EQ(reader.header->width, width);
+    EXPECT_EQ(reader.header->height, height);
+    EXPECT_EQ(reader.header->stride, width * 4);
+    EXPECT_GE(reader.header->frame_number, 1u);
+    EXPECT_EQ(reader.pixels[0], 0xAB);
+    EXPECT_EQ(reader.pixels[static_cast<size_t>(width) * height * 4 - 1], 0xAB);
+
+    preview.shutdown();
+}
+
+TEST(ShmPreviewTest, UnchangedGenerationPublishesOnce) {
+    const std::string name = unique_segment_name("gen");
+    ShmPreview preview(name, 8, 120,
+                       [](std::vector<uint8_t>& data, int& w, int& h) {
+                           w = 8;
+                           h = 8;
+                           data.assign(8 * 8 * 4, 0x10);
+                           return true;
+                       },
+                       [] { return 7ULL; });  // Generation never advances
+    ASSERT_TRUE(preview.initialize());
+    preview.start();
+    ASSERT_TRUE(wait_for_publish(preview));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    preview.stop();
+
+    EXPECT_EQ(preview.frames_published(), 1u);
+    preview.shutdown();
+}
+
+TEST(ShmPreviewTest, DownscalesWiderFrames) {
+    const std::string name = unique_segment_name("scale");
+    ShmPreview preview(name, 32, 60,
+                       [](std::vector<uint8_t>& data, int& w, int& h) {
+                           w = 64;
+                           h = 32;
+                           data.assign(64 * 32 * 4, 0x80);
+                           return true;
+                       },
+                       [] { return 1ULL; });
+    ASSERT_TRUE(preview.initialize());
+
+    ReaderMapping reader;
+    ASSERT_TRUE(reader.open(name, sizeof(ShmPreview::Header) + 32 * 32 * 4));
+
+    preview.start();
+    ASSERT_TRUE(wait_for_publish(preview));
+    preview.stop();
+
+    EXPECT_EQ(reader.header->width, 32);
+    EXPECT_EQ(reader.header->height, 16);
+    EXPECT_EQ(reader.pixels[0], 0x80);
+
+    preview.shutdown();
+}
+
+TEST(ShmPreviewTest, ShutdownUnlinksSegment) {
+    const std::string name = unique_segment_name("unlink");
+    ShmPreview preview(name, 8, 30,
+                       [](std::vector<uint8_t>&, int&, int&) { return false; },
+                       [] { return 0ULL; });
+    ASSERT_TRUE(preview.initialize());
+    preview.shutdown();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    EXPECT_LT(fd, 0);
+    if (fd >= 0) {
+        close(fd);
+    }
+}
@@ -125,3 +125,59 @@ TEST_F(WatchdogTest, StopWithoutStartIsIdempotent) {
 }
 
 
+
+TEST_F(WatchdogTest, IntervalHistogramTracksHeartbeats) {
+    Watchdog watchdog(std::chrono::seconds(10));
+    watchdog.start();
+
+    for (int i = 0; i < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        watchdog.heartbeat();
+    }
+    watchdog.stop();
+
+    auto histogram = watchdog.interval_histogram();
+    uint64_t total = 0;
+    for (auto count : histogram) {
+        total += count;
+    }
+    EXPECT_GE(total, 5u);
+    EXPECT_GE(watchdog.max_interval_ms(), 10);
+}
+
+TEST_F(WatchdogTest, StallThresholdDetectsSoftStall) {
+    Watchdog watchdog(std::chrono::seconds(10));
+    watchdog.set_stall_threshold(std::chrono::milliseconds(50));
+    EXPECT_EQ(watchdog.stall_threshold().count(), 50);
+
+    watchdog.start();
+    // No heartbeats: the gap crosses the soft threshold well before the
+    // hard timeout, and should be reported exactly once per stall
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    watchdog.stop();
+
+    EXPECT_GE(watchdog.stall_count(), 1u);
+}
+
+TEST_F(WatchdogTest, ZeroThresholdDisablesProfiling) {
+    Watchdog watchdog(std::chrono::seconds(10));
+    watchdog.set_stall_threshold(std::chrono::milliseconds(0));
+    watchdog.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    watchdog.stop();
+
+    EXPECT_EQ(watchdog.stall_count(), 0u);
+}
+
+TEST_F(WatchdogTest, RegisteredThreadBacktraceCapture) {
+    Watchdog::register_current_thread("test-main");
+
+    Watchdog watchdog(std::chrono::seconds(10));
+    watchdog.set_stall_threshold(std::chrono::milliseconds(40));
+    watchdog.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    watchdog.stop();
+
+    EXPECT_GE(watchdog.stall_count(), 1u);
+    Watchdog::unregister_current_thread();
+}
@@ -37,7 +37,8 @@ typedef enum {
     NDIlib_FourCC_video_type_BGRX = 0x58524742,  // 'BGRX'
     NDIlib_FourCC_video_type_BGRA = 0x41524742,  // 'BGRA'
     NDIlib_FourCC_video_type_RGBA = 0x41424752,  // 'RGBA'
-    NDIlib_FourCC_video_type_RGBX = 0x58424752   // 'RGBX'
+    NDIlib_FourCC_video_type_RGBX = 0x58424752,  // 'RGBX'
+    NDIlib_FourCC_video_type_UYVY = 0x59565955   // 'UYVY'
 } NDIlib_FourCC_video_type_e;
 
 // Send creation structure
@@ -89,6 +90,19 @@ typedef struct {
     const char* p_url_address;
 } NDIlib_source_t;
 
+// Frame type returned by capture calls
+typedef enum {
+    NDIlib_frame_type_none = 0,
+    NDIlib_frame_type_metadata = 5
+} NDIlib_frame_type_e;
+
+// Metadata frame (receiver -> sender messages)
+typedef struct {
+    int length;
+    int64_t timecode;
+    char* p_data;
+} NDIlib_metadata_frame_t;
+
 // Library functions
 bool NDIlib_initialize(void);
 void NDIlib_destroy(void);
@@ -98,10 +112,13 @@ const char* NDIlib_version(void);
 NDIlib_send_instance_t NDIlib_send_create(const NDIlib_send_create_t* p_create_settings);
 void NDIlib_send_destroy(NDIlib_send_instance_t p_instance);
 void NDIlib_send_send_video_v2(NDIlib_send_instance_t p_instance, const NDIlib_video_frame_v2_t* p_video_data);
+void NDIlib_send_send_video_async_v2(NDIlib_send_instance_t p_instance, const NDIlib_video_frame_v2_t* p_video_data);
 void NDIlib_send_send_audio_v3(NDIlib_send_instance_t p_instance, const NDIlib_audio_frame_v3_t* p_audio_data);
 int NDIlib_send_get_no_connections(NDIlib_send_instance_t p_instance, uint32_t timeout_in_ms);
 const NDIlib_source_t* NDIlib_send_get_source_name(NDIlib_send_instance_t p_instance);
 bool NDIlib_send_get_tally(NDIlib_send_instance_t p_instance, NDIlib_tally_t* p_tally, uint32_t timeout_in_ms);
+NDIlib_frame_type_e NDIlib_send_capture(NDIlib_send_instance_t p_instance, NDIlib_metadata_frame_t* p_metadata, uint32_t timeout_in_ms);
+void NDIlib_send_free_metadata(NDIlib_send_instance_t p_instance, const NDIlib_metadata_frame_t* p_metadata);
 
 #ifdef __cplusplus
 }
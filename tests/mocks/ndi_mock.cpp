@@ -6,6 +6,7 @@
 
 #include "Processing.NDI.Lib.h"
 #include <cstring>
+#include <ctime>
 
 // Mock state
 static bool initialized = false;
@@ -42,14 +43,25 @@ void NDIlib_send_send_video_v2(NDIlib_send_instance_t p_instance, const NDIlib_v
     }
 }
 
+void NDIlib_send_send_video_async_v2(NDIlib_send_instance_t p_instance, const NDIlib_video_frame_v2_t* p_video_data) {
+    // Async flush is a NULL frame; only count real frames
+    if (p_instance && p_video_data) {
+        mock_send_counter++;
+    }
+}
+
 void NDIlib_send_send_audio_v3(NDIlib_send_instance_t p_instance, const NDIlib_audio_frame_v3_t* p_audio_data) {
     if (p_instance && p_audio_data) {
         mock_send_counter++;
     }
 }
 
+// Test hook: harnesses can flip this (declare it extern) to simulate
+// receivers connecting and disconnecting
+int ndi_mock_connection_count = 1;
+
 int NDIlib_send_get_no_connections(NDIlib_send_instance_t p_instance, uint32_t timeout_in_ms) {
-    return 1;  // Always return 1 connection in mock
+    return ndi_mock_connection_count;
 }
 
 static NDIlib_source_t mock_source = {
@@ -69,3 +81,16 @@ bool NDIlib_send_get_tally(NDIlib_send_instance_t p_instance, NDIlib_tally_t* p_
     }
     return false;
 }
+
+NDIlib_frame_type_e NDIlib_send_capture(NDIlib_send_instance_t p_instance, NDIlib_metadata_frame_t* p_metadata, uint32_t timeout_in_ms) {
+    // Block like the real SDK would, then report no metadata
+    if (timeout_in_ms > 0) {
+        struct timespec ts{timeout_in_ms / 1000, (timeout_in_ms % 1000) * 1000000L};
+        nanosleep(&ts, nullptr);
+    }
+    return NDIlib_frame_type_none;
+}
+
+void NDIlib_send_free_metadata(NDIlib_send_instance_t p_instance, const NDIlib_metadata_frame_t* p_metadata) {
+    // No-op in mock
+}